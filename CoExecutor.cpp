@@ -0,0 +1,178 @@
+#include "CoExecutor.h"
+#include "Scheduler.h"
+#include <iostream>
+
+/**
+ * @file CoExecutor.cpp
+ * @brief Implementation of CoExecutor and of the CoTask awaitables.
+ *
+ * @details Coroutine frames are only ever touched by the thread that is
+ *          currently resuming them. Once an awaiter hands a frame to one of
+ *          the executor queues it must not access it again, because another
+ *          worker may already be running it.
+ */
+
+CoExecutor::CoExecutor(Scheduler& owner, unsigned workerCount)
+    : scheduler(owner), timerSeq(0), stopping(false) {
+    if (workerCount == 0) workerCount = 1;
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+CoExecutor::~CoExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& w : workers) w.join();
+
+    // Whatever is left is suspended and owned by us; free the frames.
+    for (void* frame : live) {
+        CoTask::Handle::from_address(frame).destroy();
+    }
+}
+
+void CoExecutor::submit(CoTask::Handle handle, int taskId) {
+    handle.promise().executor = this;
+    handle.promise().taskId = taskId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        live.insert(handle.address());
+        ready.push_back(handle);
+    }
+    workAvailable.notify_one();
+}
+
+void CoExecutor::notifyFinished(int taskId) {
+    std::size_t woken = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishedIds.insert(taskId);
+        auto it = waiters.find(taskId);
+        if (it != waiters.end()) {
+            for (auto h : it->second) ready.push_back(h);
+            woken = it->second.size();
+            waiters.erase(it);
+        }
+    }
+    if (woken == 1) workAvailable.notify_one();
+    else if (woken > 1) workAvailable.notify_all();
+}
+
+void CoExecutor::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return live.empty(); });
+}
+
+std::size_t CoExecutor::liveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return live.size();
+}
+
+void CoExecutor::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        // Move expired sleepers onto the ready queue.
+        auto now = Clock::now();
+        while (!timers.empty() && timers.top().due <= now) {
+            ready.push_back(timers.top().handle);
+            timers.pop();
+        }
+
+        if (ready.empty()) {
+            if (timers.empty()) workAvailable.wait(lock);
+            else workAvailable.wait_until(lock, timers.top().due);
+            continue;
+        }
+
+        CoTask::Handle h = ready.front();
+        ready.pop_front();
+        lock.unlock();
+
+        auto& p = h.promise();
+        if (!p.started) {
+            p.started = true;
+            scheduler.tryStartTask(p.taskId);
+        }
+        h.resume();
+
+        lock.lock();
+    }
+}
+
+void CoExecutor::schedule(CoTask::Handle handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(handle);
+    }
+    workAvailable.notify_one();
+}
+
+void CoExecutor::scheduleAt(CoTask::Handle handle, Clock::time_point due) {
+    bool earliest;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        earliest = timers.empty() || due < timers.top().due;
+        timers.push(Timer{due, timerSeq++, handle});
+    }
+    // Only a new earliest deadline changes how long idle workers should sleep.
+    if (earliest) workAvailable.notify_one();
+}
+
+bool CoExecutor::parkUntilFinished(CoTask::Handle handle, int taskId) {
+    // Tasks finished before this executor existed, or never created, are
+    // only known to the Scheduler. Ask it first, without our lock held.
+    if (!scheduler.isTaskPending(taskId)) return false;
+
+    // A finish between the check above and here has already gone through
+    // notifyFinished(), so finishedIds covers it.
+    std::lock_guard<std::mutex> lock(mutex);
+    if (finishedIds.count(taskId)) return false;
+    waiters[taskId].push_back(handle);
+    return true;
+}
+
+void CoExecutor::complete(CoTask::Handle handle) {
+    int id = handle.promise().taskId;
+    if (handle.promise().exception) {
+        // Still finish the task so waiters resume, but make the failure visible.
+        try {
+            std::rethrow_exception(handle.promise().exception);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Task [#" << id << "] threw an exception: " << e.what() << "\n";
+        } catch (...) {
+            std::cerr << "Error: Task [#" << id << "] threw an unknown exception.\n";
+        }
+        std::cerr << "Task [#" << id << "] is recorded as finished but did not complete its work.\n";
+    }
+    scheduler.tryFinishTask(id);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    live.erase(handle.address());
+    handle.destroy();
+    if (live.empty()) idle.notify_all();
+}
+
+// -------------------------
+// Awaitables
+// -------------------------
+
+void CoTask::FinalAwaiter::await_suspend(Handle h) noexcept {
+    h.promise().executor->complete(h);
+}
+
+void SleepAwaiter::await_suspend(CoTask::Handle h) const {
+    CoExecutor* ex = h.promise().executor;
+    ex->scheduleAt(h, std::chrono::steady_clock::now() + delay);
+}
+
+void YieldAwaiter::await_suspend(CoTask::Handle h) const {
+    h.promise().executor->schedule(h);
+}
+
+bool CompletionAwaiter::await_suspend(CoTask::Handle h) const {
+    return h.promise().executor->parkUntilFinished(h, taskId);
+}
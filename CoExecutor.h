@@ -0,0 +1,164 @@
+#pragma once
+
+#include "CoTask.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file CoExecutor.h
+ * @brief Declaration of the CoExecutor which runs CoTask coroutines.
+ */
+
+class Scheduler;
+
+/**
+ * @class CoExecutor
+ * @brief Multiplexes suspended task coroutines over a small pool of threads.
+ *
+ * @details The executor is owned by a Scheduler and keeps three kinds of
+ *          pending work: a FIFO of coroutines ready to run, a min-heap of
+ *          sleeping coroutines keyed by wake-up time, and coroutines parked
+ *          until another task finishes. Workers only hold a thread while a
+ *          coroutine is actually running, so thousands of mostly idle tasks
+ *          can share a handful of threads.
+ *
+ *          Lifecycle integration: the first time a coroutine is resumed the
+ *          executor calls Scheduler::tryStartTask() for it, and when the
+ *          coroutine body returns it calls Scheduler::tryFinishTask(). Both
+ *          are silent, so workers never write to the console. Completions
+ *          still take the Scheduler lock and append the CSV row, so they
+ *          are serialized on that write.
+ */
+class CoExecutor {
+public:
+    /**
+     * @brief Construct the executor and start its worker threads.
+     *
+     * @param owner Scheduler whose tasks this executor runs.
+     * @param workers Number of worker threads (at least one is started).
+     */
+    CoExecutor(Scheduler& owner, unsigned workers);
+
+    /**
+     * @brief Stop the workers and destroy any coroutines that never finished.
+     *
+     * @note Unfinished tasks stay in the Scheduler's staged/active lists.
+     */
+    ~CoExecutor();
+
+    CoExecutor(const CoExecutor&) = delete;
+    CoExecutor& operator=(const CoExecutor&) = delete;
+
+    /**
+     * @brief Take ownership of a coroutine and queue it for its first run.
+     *
+     * @param handle Coroutine frame released from a CoTask.
+     * @param taskId Scheduler task id the coroutine belongs to.
+     * @return void
+     */
+    void submit(CoTask::Handle handle, int taskId);
+
+    /**
+     * @brief Record that a task has finished and wake its awaiters.
+     *
+     * @param taskId Id of the task that reached Status::Finished.
+     * @note Called by Scheduler::finishTask() for every finished task.
+     * @return void
+     */
+    void notifyFinished(int taskId);
+
+    /**
+     * @brief Block the caller until every submitted coroutine has completed.
+     *
+     * @return void
+     */
+    void waitIdle();
+
+    /**
+     * @brief Number of coroutines submitted but not yet completed.
+     *
+     * @return std::size_t Live coroutine count.
+     */
+    std::size_t liveCount() const;
+
+private:
+    friend struct CoTask::FinalAwaiter;
+    friend struct SleepAwaiter;
+    friend struct YieldAwaiter;
+    friend struct CompletionAwaiter;
+
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Sleeping coroutine entry in the timer heap. */
+    struct Timer {
+        Clock::time_point due;
+        unsigned long long seq;
+        CoTask::Handle handle;
+
+        bool operator>(const Timer& other) const {
+            return due != other.due ? due > other.due : seq > other.seq;
+        }
+    };
+
+    /** @brief Worker thread main loop. */
+    void workerLoop();
+
+    /** @brief Queue a suspended coroutine to be resumed. */
+    void schedule(CoTask::Handle handle);
+
+    /** @brief Park a coroutine until @p due. */
+    void scheduleAt(CoTask::Handle handle, Clock::time_point due);
+
+    /**
+     * @brief Park a coroutine until task @p taskId finishes.
+     * @return bool False if the task already finished or does not exist
+     *         (resume immediately).
+     */
+    bool parkUntilFinished(CoTask::Handle handle, int taskId);
+
+    /** @brief Finish the Scheduler task of a completed coroutine and free its frame. */
+    void complete(CoTask::Handle handle);
+
+    /** @brief Scheduler that owns this executor. */
+    Scheduler& scheduler;
+
+    /** @brief Guards every container below. */
+    mutable std::mutex mutex;
+
+    /** @brief Signalled when work becomes ready or the executor stops. */
+    std::condition_variable workAvailable;
+
+    /** @brief Signalled when the last live coroutine completes. */
+    std::condition_variable idle;
+
+    /** @brief Coroutines ready to run, in FIFO order. */
+    std::deque<CoTask::Handle> ready;
+
+    /** @brief Sleeping coroutines ordered by wake-up time. */
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+
+    /** @brief Tie-breaker so timers with equal due times stay FIFO. */
+    unsigned long long timerSeq;
+
+    /** @brief Coroutines waiting on another task, keyed by that task's id. */
+    std::unordered_map<int, std::vector<CoTask::Handle>> waiters;
+
+    /** @brief Ids of tasks known to be finished. */
+    std::unordered_set<int> finishedIds;
+
+    /** @brief Every coroutine frame owned by this executor. */
+    std::unordered_set<void*> live;
+
+    /** @brief Set when the executor is shutting down. */
+    bool stopping;
+
+    /** @brief Worker threads. */
+    std::vector<std::thread> workers;
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+
+/**
+ * @file CoTask.h
+ * @brief C++20 coroutine task type and the awaitables it may suspend on.
+ *
+ * @details A CoTask is the body of a Scheduler task written as a coroutine.
+ *          Instead of blocking a worker thread while it waits on a timer or
+ *          on another task, it suspends with `co_await` and the CoExecutor
+ *          resumes it on any free worker once it can make progress.
+ *
+ *          Example:
+ *          @code
+ *          CoTask backup() {
+ *              co_await sleepFor(std::chrono::seconds(5));
+ *              co_await yieldNow();
+ *          }
+ *          int id = scheduler.spawnTask("Nightly backup", 5, backup());
+ *          @endcode
+ */
+
+class CoExecutor;
+
+/**
+ * @class CoTask
+ * @brief Move-only owner of a suspended task coroutine.
+ *
+ * @details The coroutine starts suspended and does not run until it is
+ *          handed to Scheduler::spawnTask(), which transfers ownership of
+ *          the frame to the Scheduler's CoExecutor.
+ */
+class CoTask {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief Awaiter run at the end of the coroutine.
+     *
+     * @note Side-effect: reports completion to the executor, which finishes
+     *       the Scheduler task and destroys the coroutine frame.
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Handle h) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Coroutine promise carrying the executor binding and task id.
+     */
+    struct promise_type {
+        /** @brief Executor that owns this frame (set by spawnTask). */
+        CoExecutor* executor = nullptr;
+
+        /** @brief Scheduler task id this coroutine runs for. */
+        int taskId = 0;
+
+        /** @brief True once the executor has resumed the coroutine at least once. */
+        bool started = false;
+
+        /** @brief Exception that escaped the coroutine body, if any. */
+        std::exception_ptr exception;
+
+        CoTask get_return_object() noexcept { return CoTask(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+    };
+
+    CoTask(CoTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    CoTask& operator=(CoTask&& other) noexcept;
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    /**
+     * @brief Destroy the coroutine frame if it was never handed off.
+     */
+    ~CoTask() { if (handle) handle.destroy(); }
+
+    /**
+     * @brief Give up ownership of the coroutine frame.
+     *
+     * @return Handle The frame handle; this CoTask becomes empty.
+     */
+    Handle release() noexcept { Handle h = handle; handle = nullptr; return h; }
+
+private:
+    explicit CoTask(Handle h) noexcept : handle(h) {}
+
+    /** @brief Owned coroutine frame, or null after release(). */
+    Handle handle;
+};
+
+inline CoTask& CoTask::operator=(CoTask&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @brief Awaitable that suspends the task for a period of time.
+ *
+ * @details The worker thread is released while the task sleeps; the task
+ *          is resumed by whichever worker is free once the timer expires.
+ */
+struct SleepAwaiter {
+    std::chrono::steady_clock::duration delay;
+
+    bool await_ready() const noexcept { return delay <= std::chrono::steady_clock::duration::zero(); }
+    void await_suspend(CoTask::Handle h) const;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Awaitable that re-queues the task behind other ready tasks.
+ */
+struct YieldAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(CoTask::Handle h) const;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Awaitable that suspends until another Scheduler task is finished.
+ *
+ * @details Works for both coroutine tasks and tasks finished by hand via
+ *          Scheduler::finishTask(). Resumes immediately if the task has
+ *          already finished or no task has that id.
+ */
+struct CompletionAwaiter {
+    int taskId;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(CoTask::Handle h) const;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Suspend the current task for at least @p delay.
+ *
+ * @param delay Time to sleep.
+ * @return SleepAwaiter Awaitable to `co_await`.
+ */
+inline SleepAwaiter sleepFor(std::chrono::steady_clock::duration delay) {
+    return SleepAwaiter{delay};
+}
+
+/**
+ * @brief Let other ready tasks run before continuing.
+ *
+ * @return YieldAwaiter Awaitable to `co_await`.
+ */
+inline YieldAwaiter yieldNow() {
+    return YieldAwaiter{};
+}
+
+/**
+ * @brief Suspend the current task until task @p id is finished.
+ *
+ * @param id Scheduler task id to wait for.
+ * @return CompletionAwaiter Awaitable to `co_await`.
+ */
+inline CompletionAwaiter taskCompletion(int id) {
+    return CompletionAwaiter{id};
+}
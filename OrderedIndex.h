@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @file OrderedIndex.h
+ * @brief Sorted set with O(log n) rank and positional access.
+ */
+
+/**
+ * @class OrderedIndex
+ * @brief Order-statistic tree: a sorted set that can also be indexed by position.
+ *
+ * @details Implemented as a treap (a binary search tree balanced by random
+ *          priorities) whose nodes record the size of their subtree. The
+ *          sizes let at() and rank() descend straight to a position, and
+ *          page() skip whole subtrees, so a page of k keys costs
+ *          O(log n + k) at any size. Nodes live in a vector and refer to
+ *          each other by index; erased slots are reused.
+ *
+ * @tparam Key Element type; must be copyable. Keys are unique.
+ * @tparam Compare Strict weak ordering on Key.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class OrderedIndex {
+public:
+    /**
+     * @brief Insert @p key if it is not already present.
+     *
+     * @param key Key to insert.
+     * @return bool True if the key was inserted.
+     */
+    bool insert(const Key& key);
+
+    /**
+     * @brief Remove @p key if present.
+     *
+     * @param key Key to remove.
+     * @return bool True if the key was removed.
+     */
+    bool erase(const Key& key);
+
+    /**
+     * @brief Number of keys in the index.
+     *
+     * @return std::size_t Key count.
+     */
+    std::size_t size() const { return count(root); }
+
+    /**
+     * @brief Key at ascending position @p position.
+     *
+     * @param position Zero-based position; must be less than size().
+     * @return const Key& The key with exactly @p position smaller keys.
+     */
+    const Key& at(std::size_t position) const;
+
+    /**
+     * @brief Number of keys that order before @p key.
+     *
+     * @param key Key to rank (need not be present).
+     * @return std::size_t Ascending position @p key has or would have.
+     */
+    std::size_t rank(const Key& key) const;
+
+    /**
+     * @brief Copy out up to @p limit keys starting at position @p offset.
+     *
+     * @param offset Number of keys to skip.
+     * @param limit Maximum number of keys to return.
+     * @param descending Count positions from the largest key instead of the smallest.
+     * @return std::vector<Key> Keys in the requested order.
+     */
+    std::vector<Key> page(std::size_t offset, std::size_t limit, bool descending = false) const;
+
+private:
+    static constexpr int kNil = -1;
+
+    struct Node {
+        Key key;
+        std::uint32_t priority;
+        std::size_t size;
+        int left;
+        int right;
+    };
+
+    std::size_t count(int n) const { return n == kNil ? 0 : nodes[n].size; }
+    void pull(int n) { nodes[n].size = 1 + count(nodes[n].left) + count(nodes[n].right); }
+
+    /** @brief Split @p n into keys ordering before @p key and the rest. */
+    void split(int n, const Key& key, int& less, int& rest);
+
+    /** @brief Insert node @p slot into subtree @p n; returns the new subtree root. */
+    int insertAt(int n, int slot);
+
+    /** @brief Join two treaps where every key in @p a orders before every key in @p b. */
+    int merge(int a, int b);
+
+    /** @brief Append keys at ascending positions [from, from + limit) of subtree @p n. */
+    void collect(int n, std::size_t from, std::size_t limit, std::vector<Key>& out) const;
+
+    std::uint32_t nextPriority();
+
+    std::vector<Node> nodes;
+    std::vector<int> freeSlots;
+    int root = kNil;
+    std::uint32_t seed = 2463534242u;
+    Compare less;
+};
+
+// -------------------------
+// Template implementations
+// -------------------------
+
+template <typename Key, typename Compare>
+std::uint32_t OrderedIndex<Key, Compare>::nextPriority() {
+    // xorshift32: cheap and good enough to keep the treap balanced.
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+template <typename Key, typename Compare>
+void OrderedIndex<Key, Compare>::split(int n, const Key& key, int& lo, int& hi) {
+    if (n == kNil) { lo = hi = kNil; return; }
+    if (less(nodes[n].key, key)) {
+        split(nodes[n].right, key, nodes[n].right, hi);
+        lo = n;
+    } else {
+        split(nodes[n].left, key, lo, nodes[n].left);
+        hi = n;
+    }
+    pull(n);
+}
+
+template <typename Key, typename Compare>
+int OrderedIndex<Key, Compare>::merge(int a, int b) {
+    if (a == kNil) return b;
+    if (b == kNil) return a;
+    if (nodes[a].priority > nodes[b].priority) {
+        nodes[a].right = merge(nodes[a].right, b);
+        pull(a);
+        return a;
+    }
+    nodes[b].left = merge(a, nodes[b].left);
+    pull(b);
+    return b;
+}
+
+template <typename Key, typename Compare>
+bool OrderedIndex<Key, Compare>::insert(const Key& key) {
+    // Walk down first so duplicates are rejected without restructuring.
+    for (int n = root; n != kNil;) {
+        if (less(key, nodes[n].key)) n = nodes[n].left;
+        else if (less(nodes[n].key, key)) n = nodes[n].right;
+        else return false;
+    }
+
+    Node node{key, nextPriority(), 1, kNil, kNil};
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        nodes[slot] = node;
+    } else {
+        slot = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+    }
+
+    root = insertAt(root, slot);
+    return true;
+}
+
+template <typename Key, typename Compare>
+int OrderedIndex<Key, Compare>::insertAt(int n, int slot) {
+    if (n == kNil) return slot;
+    if (nodes[slot].priority > nodes[n].priority) {
+        // The new node belongs here; the old subtree is split beneath it.
+        int lo, hi;
+        split(n, nodes[slot].key, lo, hi);
+        nodes[slot].left = lo;
+        nodes[slot].right = hi;
+        pull(slot);
+        return slot;
+    }
+    if (less(nodes[slot].key, nodes[n].key)) nodes[n].left = insertAt(nodes[n].left, slot);
+    else nodes[n].right = insertAt(nodes[n].right, slot);
+    ++nodes[n].size;
+    return n;
+}
+
+template <typename Key, typename Compare>
+bool OrderedIndex<Key, Compare>::erase(const Key& key) {
+    int n = root;
+    while (n != kNil) {
+        if (less(key, nodes[n].key)) n = nodes[n].left;
+        else if (less(nodes[n].key, key)) n = nodes[n].right;
+        else break;
+    }
+    if (n == kNil) return false;
+
+    // Walk down again, shrinking the ancestors, and splice the node out.
+    int* link = &root;
+    while (*link != n) {
+        Node& parent = nodes[*link];
+        --parent.size;
+        link = less(key, parent.key) ? &parent.left : &parent.right;
+    }
+    *link = merge(nodes[n].left, nodes[n].right);
+    freeSlots.push_back(n);
+    return true;
+}
+
+template <typename Key, typename Compare>
+const Key& OrderedIndex<Key, Compare>::at(std::size_t position) const {
+    int n = root;
+    while (true) {
+        std::size_t leftSize = count(nodes[n].left);
+        if (position < leftSize) {
+            n = nodes[n].left;
+        } else if (position == leftSize) {
+            return nodes[n].key;
+        } else {
+            position -= leftSize + 1;
+            n = nodes[n].right;
+        }
+    }
+}
+
+template <typename Key, typename Compare>
+std::size_t OrderedIndex<Key, Compare>::rank(const Key& key) const {
+    std::size_t r = 0;
+    for (int n = root; n != kNil;) {
+        if (less(nodes[n].key, key)) {
+            r += count(nodes[n].left) + 1;
+            n = nodes[n].right;
+        } else {
+            n = nodes[n].left;
+        }
+    }
+    return r;
+}
+
+template <typename Key, typename Compare>
+void OrderedIndex<Key, Compare>::collect(int n, std::size_t from, std::size_t limit,
+                                         std::vector<Key>& out) const {
+    if (n == kNil || limit == 0 || from >= nodes[n].size) return;
+    std::size_t leftSize = count(nodes[n].left);
+    std::size_t before = out.size();
+    if (from < leftSize) collect(nodes[n].left, from, limit, out);
+    std::size_t taken = out.size() - before;
+    if (taken < limit && from <= leftSize) {
+        out.push_back(nodes[n].key);
+        ++taken;
+    }
+    if (taken < limit) {
+        std::size_t rightFrom = from > leftSize ? from - leftSize - 1 : 0;
+        collect(nodes[n].right, rightFrom, limit - taken, out);
+    }
+}
+
+template <typename Key, typename Compare>
+std::vector<Key> OrderedIndex<Key, Compare>::page(std::size_t offset, std::size_t limit,
+                                                  bool descending) const {
+    std::vector<Key> out;
+    std::size_t total = size();
+    if (offset >= total || limit == 0) return out;
+    if (limit > total - offset) limit = total - offset;
+    out.reserve(limit);
+
+    if (!descending) {
+        collect(root, offset, limit, out);
+    } else {
+        collect(root, total - offset - limit, limit, out);
+        std::reverse(out.begin(), out.end());
+    }
+    return out;
+}
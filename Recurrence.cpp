@@ -0,0 +1,193 @@
+#include "Recurrence.h"
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file Recurrence.cpp
+ * @brief Implementation of CronExpression and RecurringTask.
+ */
+
+namespace {
+
+/**
+ * @brief Parse one cron field into a bitset of allowed values.
+ *
+ * @param field Field text, e.g. "1-5", "0-30/15", "0,30".
+ * @param lo Smallest allowed value.
+ * @param hi Largest allowed value.
+ * @param name Field name used in error messages.
+ * @return std::vector<bool> Allowed flags indexed by value.
+ * @throws std::invalid_argument On malformed or out-of-range input.
+ */
+std::vector<bool> parseField(const std::string& field, int lo, int hi, const char* name) {
+    std::vector<bool> allowed(hi + 1, false);
+    auto fail = [&](const std::string& why) {
+        throw std::invalid_argument(std::string("cron ") + name + " field '" + field + "': " + why);
+    };
+    // Nine digits always fit in an int, so longer numbers are rejected before std::stoi can throw.
+    auto toNumber = [&](const std::string& s, const char* what) {
+        if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos) fail(std::string("expected a ") + what);
+        if (s.size() > 9) fail(std::string(what) + " " + s + " out of range");
+        return std::stoi(s);
+    };
+    auto toInt = [&](const std::string& s) {
+        int v = toNumber(s, "number");
+        if (v < lo || v > hi) fail("value " + s + " out of range");
+        return v;
+    };
+
+    std::stringstream parts(field);
+    std::string part;
+    while (std::getline(parts, part, ',')) {
+        int step = 1;
+        std::size_t slash = part.find('/');
+        std::string base = part.substr(0, slash);
+        if (slash != std::string::npos) {
+            step = toNumber(part.substr(slash + 1), "step");
+            if (step == 0) fail("step must be positive");
+        }
+
+        int first = lo, last = hi;
+        if (base != "*") {
+            std::size_t dash = base.find('-');
+            first = toInt(base.substr(0, dash));
+            last = dash == std::string::npos ? (slash == std::string::npos ? first : hi)
+                                             : toInt(base.substr(dash + 1));
+            if (first > last) fail("range is reversed");
+        }
+        for (int v = first; v <= last; v += step) allowed[v] = true;
+    }
+    if (field.empty() || field.back() == ',') fail("empty list entry");
+    return allowed;
+}
+
+/** @brief Normalize @p tm through mktime, letting it pick DST. */
+std::time_t normalize(std::tm& tm) {
+    tm.tm_isdst = -1;
+    return std::mktime(&tm);
+}
+
+/** @brief Format a timestamp the same way Task::getDetails does. */
+std::string formatTime(std::time_t t) {
+    if (t == 0) return "N/A";
+    char* s = std::ctime(&t);
+    std::string out = s ? std::string(s) : std::string("N/A");
+    if (!out.empty() && out.back() == '\n') out.pop_back();
+    return out;
+}
+
+} // namespace
+
+CronExpression::CronExpression(const std::string& expr) : source(expr) {
+    std::stringstream ss(expr);
+    std::vector<std::string> fields;
+    std::string f;
+    while (ss >> f) fields.push_back(f);
+    if (fields.size() != 5) {
+        throw std::invalid_argument("cron expression '" + expr + "' must have 5 fields");
+    }
+
+    auto copy = [](const std::vector<bool>& from, auto& to, int lo) {
+        for (std::size_t v = lo; v < from.size(); ++v) to[v] = from[v];
+    };
+    copy(parseField(fields[0], 0, 59, "minute"), minutes, 0);
+    copy(parseField(fields[1], 0, 23, "hour"), hours, 0);
+    copy(parseField(fields[2], 1, 31, "day-of-month"), daysOfMonth, 1);
+    copy(parseField(fields[3], 1, 12, "month"), months, 1);
+
+    std::vector<bool> dow = parseField(fields[4], 0, 7, "day-of-week");
+    for (int d = 0; d < 7; ++d) daysOfWeek[d] = dow[d];
+    if (dow[7]) daysOfWeek[0] = true;
+
+    // As in standard cron, a field starting with '*' (including "*/n") counts as unrestricted.
+    domRestricted = fields[2][0] != '*';
+    dowRestricted = fields[4][0] != '*';
+}
+
+bool CronExpression::dayMatches(const std::tm& tm) const {
+    bool dom = daysOfMonth[tm.tm_mday];
+    bool dow = daysOfWeek[tm.tm_wday];
+    if (domRestricted && dowRestricted) return dom || dow;
+    return dom && dow;
+}
+
+std::time_t CronExpression::nextAfter(std::time_t after) const {
+    std::tm tm = *std::localtime(&after);
+    const int lastYear = tm.tm_year + 5;
+    tm.tm_sec = 0;
+    tm.tm_min += 1;
+    std::time_t t = normalize(tm);
+
+    // Advance by the coarsest field that does not match, so the search is
+    // bounded by days rather than minutes.
+    while (true) {
+        tm = *std::localtime(&t);
+        if (tm.tm_year > lastYear) return 0;
+
+        if (!months[tm.tm_mon + 1]) {
+            tm.tm_mon += 1; tm.tm_mday = 1; tm.tm_hour = 0; tm.tm_min = 0;
+        } else if (!dayMatches(tm)) {
+            tm.tm_mday += 1; tm.tm_hour = 0; tm.tm_min = 0;
+        } else if (!hours[tm.tm_hour]) {
+            tm.tm_hour += 1; tm.tm_min = 0;
+        } else if (!minutes[tm.tm_min]) {
+            tm.tm_min += 1;
+        } else {
+            return t;
+        }
+        std::time_t advanced = normalize(tm);
+        // A DST gap can map the requested time back onto itself; step past it.
+        t = advanced > t ? advanced : t + 60;
+    }
+}
+
+// -------------------------
+// RecurringTask
+// -------------------------
+
+RecurringTask::RecurringTask(int id_, const std::string& description_, int estimate,
+                             long long interval, std::time_t firstFire, CatchUpPolicy policy)
+    : id(id_), description(description_), estimatedDurationSeconds(estimate),
+      kind(RecurrenceKind::Interval), intervalSeconds(interval), cron("* * * * *"),
+      catchUp(policy), nextFire(firstFire) {
+    if (interval <= 0) throw std::invalid_argument("recurrence interval must be positive");
+    if (interval > kMaxIntervalSeconds) throw std::invalid_argument("recurrence interval is too long");
+}
+
+RecurringTask::RecurringTask(int id_, const std::string& description_, int estimate,
+                             const CronExpression& cron_, std::time_t now, CatchUpPolicy policy)
+    : id(id_), description(description_), estimatedDurationSeconds(estimate),
+      kind(RecurrenceKind::Cron), intervalSeconds(0), cron(cron_),
+      catchUp(policy), nextFire(cron_.nextAfter(now)) {
+    if (nextFire == 0) throw std::invalid_argument("cron expression '" + cron_.text() + "' never matches");
+}
+
+std::time_t RecurringTask::fireAfter(std::time_t t) const {
+    if (kind == RecurrenceKind::Interval) {
+        if (t > std::numeric_limits<std::time_t>::max() - intervalSeconds) return 0;
+        return t + static_cast<std::time_t>(intervalSeconds);
+    }
+    return cron.nextAfter(t);
+}
+
+std::string RecurringTask::getDetails() const {
+    std::string result = "[R#" + std::to_string(id) + "] " + description;
+    if (kind == RecurrenceKind::Interval) {
+        result += " | Every: " + std::to_string(intervalSeconds) + " sec";
+    } else {
+        result += " | Cron: " + cron.text();
+    }
+    result += " | Estimate: " + std::to_string(estimatedDurationSeconds) + " sec";
+
+    std::string policy;
+    switch (catchUp) {
+        case CatchUpPolicy::RunOnce: policy = "run once"; break;
+        case CatchUpPolicy::RunAll: policy = "run all"; break;
+        case CatchUpPolicy::Skip: policy = "skip"; break;
+    }
+    result += " | Catch-up: " + policy;
+    result += " | Next: " + formatTime(nextFire);
+    return result;
+}
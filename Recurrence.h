@@ -0,0 +1,168 @@
+#pragma once
+
+#include <bitset>
+#include <ctime>
+#include <string>
+
+/**
+ * @file Recurrence.h
+ * @brief Recurring task definitions: fixed-interval and cron-style schedules.
+ */
+
+/**
+ * @class CronExpression
+ * @brief Parsed five-field cron expression evaluated in local time.
+ *
+ * @details Fields are `minute hour day-of-month month day-of-week`. Each
+ *          field accepts `*`, single values, ranges (`a-b`), lists (`a,b`)
+ *          and steps (`a-b/n`, or `*` followed by `/n`). Day of
+ *          week uses 0-6 with 0 = Sunday (7 is also accepted as Sunday). As
+ *          in classic cron, when both day fields are restricted (do not
+ *          start with `*`) a day matches if either of them matches.
+ */
+class CronExpression {
+public:
+    /**
+     * @brief Parse a cron expression.
+     *
+     * @param expr Five whitespace-separated fields, e.g. "0 9 * * 1-5".
+     * @throws std::invalid_argument If the expression is malformed.
+     */
+    explicit CronExpression(const std::string& expr);
+
+    /**
+     * @brief Compute the first matching minute strictly after @p after.
+     *
+     * @param after Reference time.
+     * @return std::time_t Next fire time, or 0 if nothing matches within
+     *         the next few years (e.g. "0 0 30 2 *").
+     */
+    std::time_t nextAfter(std::time_t after) const;
+
+    /**
+     * @brief Get the expression text as given to the constructor.
+     *
+     * @return const std::string& Original expression.
+     */
+    const std::string& text() const { return source; }
+
+private:
+    /** @brief Does the calendar day described by @p tm match the day fields? */
+    bool dayMatches(const std::tm& tm) const;
+
+    std::string source;
+    std::bitset<60> minutes;
+    std::bitset<24> hours;
+    std::bitset<32> daysOfMonth;
+    std::bitset<13> months;
+    std::bitset<7> daysOfWeek;
+    bool domRestricted;
+    bool dowRestricted;
+};
+
+/**
+ * @enum CatchUpPolicy
+ * @brief What to do with fire times that passed while nothing released them.
+ */
+enum class CatchUpPolicy {
+    /** @brief Missed fire times are coalesced into a single run. */
+    RunOnce,
+    /** @brief Every missed fire time gets its own run (up to a cap). */
+    RunAll,
+    /** @brief If more than one fire time was missed, none of them run. */
+    Skip
+};
+
+/**
+ * @enum RecurrenceKind
+ * @brief How a RecurringTask computes its fire times.
+ */
+enum class RecurrenceKind {
+    /** @brief Every `intervalSeconds` from the first fire time. */
+    Interval,
+    /** @brief Whenever `cron` matches. */
+    Cron
+};
+
+/**
+ * @class RecurringTask
+ * @brief Template from which the Scheduler instantiates staged task runs.
+ *
+ * @details A RecurringTask never appears in the task lists itself; each time
+ *          it comes due the Scheduler stages a fresh Task with the same
+ *          description and estimate.
+ */
+class RecurringTask {
+public:
+    /**
+     * @brief Construct a fixed-interval definition.
+     *
+     * @param id Recurrence identifier (independent of task ids).
+     * @param description Description given to every run.
+     * @param estimate Estimated duration in seconds for every run.
+     * @param intervalSeconds Seconds between fire times (must be positive).
+     * @param firstFire Time of the first run.
+     * @param policy Catch-up policy for missed runs.
+     * @throws std::invalid_argument If @p intervalSeconds is not positive or
+     *         exceeds kMaxIntervalSeconds.
+     */
+    RecurringTask(int id, const std::string& description, int estimate,
+                  long long intervalSeconds, std::time_t firstFire, CatchUpPolicy policy);
+
+    /**
+     * @brief Construct a cron-style definition.
+     *
+     * @param id Recurrence identifier (independent of task ids).
+     * @param description Description given to every run.
+     * @param estimate Estimated duration in seconds for every run.
+     * @param cron Parsed cron expression.
+     * @param now Current time; the first run is the next match after it.
+     * @param policy Catch-up policy for missed runs.
+     * @throws std::invalid_argument If the expression never matches.
+     */
+    RecurringTask(int id, const std::string& description, int estimate,
+                  const CronExpression& cron, std::time_t now, CatchUpPolicy policy);
+
+    /**
+     * @brief Fire time following @p t according to this schedule.
+     *
+     * @param t A fire time of this schedule (or any reference time).
+     * @return std::time_t Next fire time, or 0 if the schedule is exhausted
+     *         (including when the next time would not fit in std::time_t).
+     */
+    std::time_t fireAfter(std::time_t t) const;
+
+    /**
+     * @brief Return a human readable summary of the definition.
+     *
+     * @return std::string Formatted details for display.
+     */
+    std::string getDetails() const;
+
+    /** @brief Longest accepted interval: 100 years. */
+    static constexpr long long kMaxIntervalSeconds = 100LL * 365 * 24 * 60 * 60;
+
+    /** @brief Unique recurrence identifier. */
+    int id;
+
+    /** @brief Description copied into each run. */
+    std::string description;
+
+    /** @brief Estimated duration in seconds copied into each run. */
+    int estimatedDurationSeconds;
+
+    /** @brief Interval or cron schedule. */
+    RecurrenceKind kind;
+
+    /** @brief Period for RecurrenceKind::Interval (unused for cron). */
+    long long intervalSeconds;
+
+    /** @brief Expression for RecurrenceKind::Cron (matches every minute for intervals). */
+    CronExpression cron;
+
+    /** @brief Catch-up policy for missed runs. */
+    CatchUpPolicy catchUp;
+
+    /** @brief Next time a run is due (0 once the schedule is exhausted). */
+    std::time_t nextFire;
+};
@@ -0,0 +1,289 @@
+#include "RotatingCsvLog.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <zlib.h>
+
+/**
+ * @file RotatingCsvLog.cpp
+ * @brief Implementation of RotatingCsvLog.
+ *
+ * @details Segments are compressed with zlib's gzip writer, so link with
+ *          `-lz`. The resulting `.csv.gz` files open with standard tools
+ *          (`zcat`, `gzip -d`).
+ */
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief Gzip @p src into @p dst.
+ *
+ * @return bool True on success; on failure @p dst is removed.
+ */
+bool gzipFile(const std::string& src, const std::string& dst) {
+    std::ifstream in(src, std::ios::binary);
+    if (!in) return false;
+    gzFile out = gzopen(dst.c_str(), "wb6");
+    if (!out) return false;
+
+    std::vector<char> buffer(1 << 16);
+    bool ok = true;
+    while (ok && (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0)) {
+        ok = gzwrite(out, buffer.data(), static_cast<unsigned>(in.gcount())) > 0;
+    }
+    ok = gzclose(out) == Z_OK && ok && !in.bad();
+    if (!ok) {
+        std::error_code ec;
+        fs::remove(dst, ec);
+    }
+    return ok;
+}
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+RotatingCsvLog::RotatingCsvLog(const std::string& base, const std::string& headerRow,
+                               const LogRotationPolicy& rotation,
+                               std::function<std::time_t(const std::string&)> parser)
+    : baseName(base), activeFile(base + ".csv"), manifestFile(base + ".manifest.csv"),
+      header(headerRow), policy(rotation), rowTimeParser(std::move(parser)), opened(false),
+      activeBytes(0), activeRows(0), activeFirstTime(0), activeLastTime(0), nextSegmentId(1),
+      compressing(false), compressingId(0), stopping(false) {}
+
+RotatingCsvLog::~RotatingCsvLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (active.is_open()) active.close();
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    if (compressor.joinable()) compressor.join();
+}
+
+void RotatingCsvLog::openLocked() {
+    opened = true;
+
+    // Reload the manifest left by a previous run.
+    std::ifstream manifest(manifestFile);
+    std::string line;
+    bool repaired = false;
+    if (manifest && std::getline(manifest, line)) {
+        while (std::getline(manifest, line)) {
+            std::stringstream ss(line);
+            std::string id, file, first, last, rows, bytes;
+            if (!std::getline(ss, id, ',') || !std::getline(ss, file, ',') || !std::getline(ss, first, ',') ||
+                !std::getline(ss, last, ',') || !std::getline(ss, rows, ',') || !std::getline(ss, bytes, ',')) {
+                continue;
+            }
+            try {
+                LogSegment seg{std::stoi(id), file, static_cast<std::time_t>(std::stoll(first)),
+                               static_cast<std::time_t>(std::stoll(last)),
+                               static_cast<std::size_t>(std::stoull(rows)), std::stoull(bytes)};
+                if (!fs::exists(seg.file)) {
+                    // A crash after compressing but before the manifest was
+                    // rewritten leaves the entry naming the deleted .csv.
+                    std::error_code ec;
+                    std::uintmax_t size = fs::file_size(seg.file + ".gz", ec);
+                    if (endsWith(seg.file, ".gz") || ec) continue;
+                    seg.file += ".gz";
+                    seg.bytes = size;
+                    repaired = true;
+                }
+                segments.push_back(seg);
+                nextSegmentId = std::max(nextSegmentId, seg.id + 1);
+            } catch (...) {
+                // Skip malformed entries rather than refusing to log.
+            }
+        }
+    }
+    if (repaired) writeManifestLocked();
+    for (const auto& seg : segments) {
+        if (!endsWith(seg.file, ".gz")) enqueueLocked(seg.id);
+    }
+
+    // Resume an active file left by a previous run.
+    std::ifstream existing(activeFile);
+    if (existing && std::getline(existing, line)) {
+        activeBytes = line.size() + 1;
+        while (std::getline(existing, line)) {
+            activeBytes += line.size() + 1;
+            if (line.empty()) continue;
+            ++activeRows;
+            std::time_t t = rowTimeParser ? rowTimeParser(line) : 0;
+            if (t != 0) {
+                if (activeFirstTime == 0) activeFirstTime = t;
+                activeLastTime = t;
+            }
+        }
+        active.open(activeFile, std::ios::app);
+    }
+}
+
+bool RotatingCsvLog::append(const std::string& row, std::time_t rowTime) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!opened) openLocked();
+
+    if (activeRows > 0) {
+        bool tooBig = policy.maxSegmentBytes != 0 && activeBytes + row.size() + 1 > policy.maxSegmentBytes;
+        bool tooOld = policy.maxSegmentSeconds != 0 && activeFirstTime != 0 &&
+                      rowTime - activeFirstTime >= policy.maxSegmentSeconds;
+        if (tooBig || tooOld) rotateLocked();
+    }
+
+    if (!active.is_open()) {
+        active.open(activeFile, std::ios::trunc);
+        if (!active) return false;
+        active << header << '\n';
+        activeBytes = header.size() + 1;
+    }
+
+    active << row << '\n';
+    active.flush();
+    activeBytes += row.size() + 1;
+    ++activeRows;
+    if (activeFirstTime == 0) activeFirstTime = rowTime;
+    activeLastTime = rowTime;
+    return static_cast<bool>(active);
+}
+
+void RotatingCsvLog::rotate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!opened) openLocked();
+    rotateLocked();
+}
+
+void RotatingCsvLog::rotateLocked() {
+    if (activeRows == 0) return;
+    active.close();
+
+    // Never reuse the name of a segment file the manifest does not know about.
+    int id;
+    std::string file;
+    do {
+        id = nextSegmentId++;
+        file = baseName + "." + std::to_string(id) + ".csv";
+    } while (fs::exists(file) || fs::exists(file + ".gz"));
+
+    std::error_code ec;
+    fs::rename(activeFile, file, ec);
+    if (ec) {
+        std::cerr << "Error: Could not rotate " << activeFile << ": " << ec.message() << "\n";
+        active.open(activeFile, std::ios::app);
+        return;
+    }
+
+    segments.push_back({id, file, activeFirstTime, activeLastTime, activeRows, activeBytes});
+    activeBytes = 0;
+    activeRows = 0;
+    activeFirstTime = 0;
+    activeLastTime = 0;
+
+    enforceRetentionLocked();
+    writeManifestLocked();
+    enqueueLocked(id);
+}
+
+void RotatingCsvLog::setPolicy(const LogRotationPolicy& newPolicy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    policy = newPolicy;
+}
+
+std::vector<LogSegment> RotatingCsvLog::getSegments() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return segments;
+}
+
+void RotatingCsvLog::waitForCompression() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return pending.empty() && !compressing; });
+}
+
+void RotatingCsvLog::writeManifestLocked() const {
+    const std::string tmp = manifestFile + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            std::cerr << "Error: Could not write " << manifestFile << ".\n";
+            return;
+        }
+        out << "Segment,File,First Time (epoch),Last Time (epoch),Rows,Bytes\n";
+        for (const auto& seg : segments) {
+            out << seg.id << "," << seg.file << "," << static_cast<long long>(seg.firstTime) << ","
+                << static_cast<long long>(seg.lastTime) << "," << seg.rows << "," << seg.bytes << "\n";
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, manifestFile, ec);
+}
+
+void RotatingCsvLog::enforceRetentionLocked() {
+    std::uintmax_t total = 0;
+    for (const auto& seg : segments) total += seg.bytes;
+
+    // Segments whose compression failed are removed too, so they cannot pin
+    // the archive; only the one the worker is reading right now is spared.
+    while (!segments.empty() && !(compressing && segments.front().id == compressingId) &&
+           ((policy.maxSegments != 0 && segments.size() > policy.maxSegments) ||
+            (policy.maxArchiveBytes != 0 && total > policy.maxArchiveBytes))) {
+        std::error_code ec;
+        fs::remove(segments.front().file, ec);
+        total -= segments.front().bytes;
+        segments.erase(segments.begin());
+    }
+}
+
+void RotatingCsvLog::enqueueLocked(int segmentId) {
+    pending.push_back(segmentId);
+    if (!compressor.joinable()) {
+        compressor = std::thread([this] { compressLoop(); });
+    }
+    workAvailable.notify_one();
+}
+
+void RotatingCsvLog::compressLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        if (pending.empty()) drained.notify_all();
+        workAvailable.wait(lock, [this] { return stopping || !pending.empty(); });
+        // Pending segments are finished even when stopping so none stay uncompressed.
+        if (pending.empty()) break;
+
+        int id = pending.front();
+        pending.pop_front();
+        auto it = std::find_if(segments.begin(), segments.end(), [id](const LogSegment& s) { return s.id == id; });
+        if (it == segments.end() || endsWith(it->file, ".gz")) continue;
+        const std::string src = it->file;
+        const std::string dst = src + ".gz";
+
+        compressing = true;
+        compressingId = id;
+        lock.unlock();
+        bool ok = gzipFile(src, dst + ".tmp");
+        std::error_code ec;
+        if (ok) fs::rename(dst + ".tmp", dst, ec);
+        ok = ok && !ec;
+        std::uintmax_t bytes = ok ? fs::file_size(dst, ec) : 0;
+        if (ok) fs::remove(src, ec);
+        lock.lock();
+        compressing = false;
+
+        if (ok) {
+            it = std::find_if(segments.begin(), segments.end(), [id](const LogSegment& s) { return s.id == id; });
+            if (it != segments.end()) {
+                it->file = dst;
+                it->bytes = bytes;
+            }
+            enforceRetentionLocked();
+            writeManifestLocked();
+        } else {
+            std::cerr << "Error: Could not compress " << src << ".\n";
+        }
+    }
+    drained.notify_all();
+}
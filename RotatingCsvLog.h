@@ -0,0 +1,209 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file RotatingCsvLog.h
+ * @brief Append-only CSV log split into numbered, compressed segments.
+ */
+
+/**
+ * @struct LogRotationPolicy
+ * @brief Limits that decide when the active file is rotated and what is kept.
+ *
+ * @note A limit of 0 disables it.
+ */
+struct LogRotationPolicy {
+    /** @brief Rotate before the active file would grow past this many bytes. */
+    std::uintmax_t maxSegmentBytes = 1024 * 1024;
+
+    /** @brief Rotate once the active file spans this many seconds of rows. */
+    long long maxSegmentSeconds = 24 * 60 * 60;
+
+    /** @brief Delete the oldest closed segments beyond this count. */
+    std::size_t maxSegments = 30;
+
+    /** @brief Delete the oldest closed segments while they use more bytes than this. */
+    std::uintmax_t maxArchiveBytes = 0;
+};
+
+/**
+ * @struct LogSegment
+ * @brief Manifest entry describing one closed segment.
+ */
+struct LogSegment {
+    /** @brief Segment number, increasing with age (1 is the oldest ever written). */
+    int id;
+
+    /** @brief File name of the segment (`.csv` until compressed, then `.csv.gz`). */
+    std::string file;
+
+    /** @brief Time of the first row in the segment. */
+    std::time_t firstTime;
+
+    /** @brief Time of the last row in the segment. */
+    std::time_t lastTime;
+
+    /** @brief Number of data rows (header excluded). */
+    std::size_t rows;
+
+    /** @brief Size of the segment file on disk. */
+    std::uintmax_t bytes;
+};
+
+/**
+ * @class RotatingCsvLog
+ * @brief CSV log whose active file stays small and whose history is compressed.
+ *
+ * @details Rows are appended to `<base>.csv` through a stream that stays
+ *          open. When the next row would exceed the policy's size or time
+ *          span, the active file is closed and renamed to `<base>.<id>.csv`,
+ *          and a background thread gzips it to `<base>.<id>.csv.gz`. Every
+ *          segment starts with the header row, so each one is a complete CSV
+ *          file on its own.
+ *
+ *          `<base>.manifest.csv` lists every closed segment with its id,
+ *          file name, first/last row time (epoch seconds), row count and
+ *          size, so a reader looking for a time range can open only the
+ *          segments that overlap it. The manifest is rewritten atomically
+ *          after each change and reloaded on start-up; segments a previous
+ *          run rotated but did not finish compressing are compressed again,
+ *          and entries whose `.csv` was already replaced by its `.csv.gz`
+ *          are pointed at the compressed file.
+ */
+class RotatingCsvLog {
+public:
+    /**
+     * @brief Construct a log; nothing is touched on disk until the first append.
+     *
+     * @param baseName Path prefix for the active file, segments and manifest.
+     * @param header Header row (without newline) written at the top of each segment.
+     * @param policy Rotation and retention limits.
+     * @param rowTimeParser Extracts a row's time; only used to recover the
+     *        time range of an active file left by a previous run.
+     */
+    RotatingCsvLog(const std::string& baseName, const std::string& header,
+                   const LogRotationPolicy& policy = LogRotationPolicy(),
+                   std::function<std::time_t(const std::string&)> rowTimeParser = nullptr);
+
+    /**
+     * @brief Close the active file and finish any pending compression.
+     */
+    ~RotatingCsvLog();
+
+    RotatingCsvLog(const RotatingCsvLog&) = delete;
+    RotatingCsvLog& operator=(const RotatingCsvLog&) = delete;
+
+    /**
+     * @brief Append one row, rotating first if a limit would be exceeded.
+     *
+     * @param row CSV row without trailing newline.
+     * @param rowTime Time the row describes; drives time-based rotation and
+     *        the manifest's time ranges.
+     * @return bool False if the active file could not be opened or written.
+     */
+    bool append(const std::string& row, std::time_t rowTime);
+
+    /**
+     * @brief Close the active file as a segment now, if it has any rows.
+     *
+     * @return void
+     */
+    void rotate();
+
+    /**
+     * @brief Replace the rotation and retention limits.
+     *
+     * @param newPolicy Limits applied from the next append on.
+     * @return void
+     */
+    void setPolicy(const LogRotationPolicy& newPolicy);
+
+    /**
+     * @brief Get a snapshot of the manifest, oldest segment first.
+     *
+     * @return std::vector<LogSegment> Closed segments still on disk.
+     */
+    std::vector<LogSegment> getSegments() const;
+
+    /**
+     * @brief Block until every rotated segment has been compressed.
+     *
+     * @return void
+     */
+    void waitForCompression();
+
+    /**
+     * @brief Path of the active file.
+     *
+     * @return const std::string& `<base>.csv`.
+     */
+    const std::string& activePath() const { return activeFile; }
+
+private:
+    /** @brief Load the manifest and reopen the active file (first append only). */
+    void openLocked();
+
+    /** @brief Body of rotate(); caller holds `mutex`. */
+    void rotateLocked();
+
+    /** @brief Rewrite the manifest file from `segments`; caller holds `mutex`. */
+    void writeManifestLocked() const;
+
+    /** @brief Delete the oldest closed segments beyond the policy; caller holds `mutex`. */
+    void enforceRetentionLocked();
+
+    /** @brief Queue a segment for compression, starting the worker if needed. */
+    void enqueueLocked(int segmentId);
+
+    /** @brief Background thread: gzip queued segments. */
+    void compressLoop();
+
+    std::string baseName;
+    std::string activeFile;
+    std::string manifestFile;
+    std::string header;
+    LogRotationPolicy policy;
+    std::function<std::time_t(const std::string&)> rowTimeParser;
+
+    /** @brief Guards every member below. */
+    mutable std::mutex mutex;
+
+    /** @brief True once openLocked() has run. */
+    bool opened;
+
+    /** @brief Open stream to the active file. */
+    std::ofstream active;
+
+    /** @brief Bytes currently in the active file. */
+    std::uintmax_t activeBytes;
+
+    /** @brief Data rows in the active file and their time range. */
+    std::size_t activeRows;
+    std::time_t activeFirstTime;
+    std::time_t activeLastTime;
+
+    /** @brief Closed segments, oldest first. */
+    std::vector<LogSegment> segments;
+
+    /** @brief Id to give the next rotated segment. */
+    int nextSegmentId;
+
+    /** @brief Segment ids waiting to be compressed, and the worker state. */
+    std::deque<int> pending;
+    bool compressing;
+    int compressingId;
+    bool stopping;
+    std::condition_variable workAvailable;
+    std::condition_variable drained;
+    std::thread compressor;
+};
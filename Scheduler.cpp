@@ -1,9 +1,10 @@
 #include "Scheduler.h"
+#include "CoExecutor.h"
 #include <iostream>
 #include <algorithm>
 #include <ctime>
-#include <fstream>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 /**
@@ -17,54 +18,161 @@
 /**
  * @brief Construct a new Scheduler object and initialize id counter.
  *
- * @note Initializes `nextId` to 1.
+ * @note Initializes `nextId` and `nextRecurrenceId` to 1 and sets up the
+ *       rotating finished-task log (nothing is written until a task finishes).
  * @return void
  */
-Scheduler::Scheduler() : nextId(1) {}
+Scheduler::Scheduler()
+    : nextId(1), nextRecurrenceId(1),
+      csvLog("finished_tasks",
+             "ID,Description,Estimated Duration (sec),Start Time,Finish Time,Actual Duration (sec)",
+             LogRotationPolicy(), &Scheduler::csvRowFinishTime) {}
+
+/**
+ * @brief Stop the executor before the task lists it updates are destroyed.
+ */
+Scheduler::~Scheduler() {
+    executor.reset();
+}
+
+
+void Scheduler::setClock(std::function<std::time_t()> source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    clock = std::move(source);
+}
+
+
+std::time_t Scheduler::now() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentTime();
+}
+
+
+std::time_t Scheduler::currentTime() const {
+    return clock ? clock() : std::time(nullptr);
+}
 
 
 void Scheduler::addTask(const std::string& description, int estimate) {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    addTaskLocked(description, estimate);
+}
+
+
+int Scheduler::addTaskLocked(const std::string& description, int estimate) {
     Task t(nextId++, description, estimate);
     stagedTasks.push_back(t);
+    searchIndex.add(t);
+    stagedByEstimate.insert({sortValue(t, SortKey::Estimate), t.id});
     std::cout << "Added task [#" << t.id << "] to staged tasks.\n";
+    return t.id;
+}
+
+
+int Scheduler::spawnTask(const std::string& description, int estimate, CoTask body) {
+    CoExecutor& ex = getExecutor();
+    int id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = addTaskLocked(description, estimate);
+    }
+    ex.submit(body.release(), id);
+    return id;
+}
+
+
+CoExecutor& Scheduler::getExecutor() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!executor) {
+        executor = std::make_unique<CoExecutor>(*this, std::thread::hardware_concurrency());
+    }
+    return *executor;
+}
+
+
+bool Scheduler::isTaskPending(int id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Task* t = searchIndex.find(id);
+    return t && t->status != Status::Finished;
 }
 
 
 void Scheduler::startTask(int id) {
-    Task* t = findTaskById(id, stagedTasks);
-    if (!t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    if (!startTaskLocked(id)) {
         std::cout << "Task [#" << id << "] not found in staged tasks.\n";
         return;
     }
+    std::cout << "Started task [#" << id << "].\n";
+}
+
+
+bool Scheduler::tryStartTask(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    return startTaskLocked(id);
+}
+
+
+bool Scheduler::startTaskLocked(int id) {
+    Task* t = findTaskById(id, stagedTasks);
+    if (!t) return false;
 
     // Mark active on the actual object in stagedTasks, then move it
-    t->markActive();
+    t->markActive(currentTime());
+    searchIndex.update(*t);
+    stagedByEstimate.erase({sortValue(*t, SortKey::Estimate), t->id});
     // copy to active list and remove from staged
     activeTasks.push_back(*t);
     // remove original from stagedTasks
     stagedTasks.erase(std::remove_if(stagedTasks.begin(), stagedTasks.end(), [id](const Task& x){ return x.id == id; }), stagedTasks.end());
-
-    std::cout << "Started task [#" << id << "].\n";
+    return true;
 }
 
 
 void Scheduler::finishTask(int id) {
-    Task* t = findTaskById(id, activeTasks);
-    if (!t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    bool logged = false;
+    if (!finishTaskLocked(id, logged)) {
         std::cout << "Task [#" << id << "] not found in active tasks.\n";
         return;
     }
+    if (logged) std::cout << "Task logged to " << csvLog.activePath() << "\n";
+    std::cout << "Finished task [#" << id << "].\n";
+}
+
 
-    t->markFinished();
+bool Scheduler::tryFinishTask(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    bool logged = false;
+    return finishTaskLocked(id, logged);
+}
+
+
+bool Scheduler::finishTaskLocked(int id, bool& logged) {
+    Task* t = findTaskById(id, activeTasks);
+    if (!t) return false;
+
+    t->markFinished(currentTime());
+    searchIndex.update(*t);
+    finishedByDuration.insert({sortValue(*t, SortKey::ActualDuration), t->id});
+    finishedByOverrun.insert({sortValue(*t, SortKey::Overrun), t->id});
+    finishedByFinishTime.insert({sortValue(*t, SortKey::FinishTime), t->id});
     finishedLog.push_back(*t);
     activeTasks.erase(std::remove_if(activeTasks.begin(), activeTasks.end(), [id](const Task& x){ return x.id == id; }), activeTasks.end());
 
-    logTaskToCSV(*t);
-    std::cout << "Finished task [#" << id << "].\n";
+    logged = logTaskToCSV(finishedLog.back());
+    if (executor) executor->notifyFinished(id);
+    return true;
 }
 
 
 void Scheduler::viewStagedTasks() const {
+    std::lock_guard<std::mutex> lock(mutex);
     std::cout << "--- Staged Tasks (" << stagedTasks.size() << ") ---\n";
     if (stagedTasks.empty()) {
         std::cout << "(none)\n";
@@ -77,6 +185,7 @@ void Scheduler::viewStagedTasks() const {
 
 
 void Scheduler::viewActiveTasks() const {
+    std::lock_guard<std::mutex> lock(mutex);
     std::cout << "--- Active Tasks (" << activeTasks.size() << ") ---\n";
     if (activeTasks.empty()) {
         std::cout << "(none)\n";
@@ -89,6 +198,7 @@ void Scheduler::viewActiveTasks() const {
 
 
 void Scheduler::printLog() const {
+    std::lock_guard<std::mutex> lock(mutex);
     std::cout << "--- Finished Tasks Log (" << finishedLog.size() << ") ---\n";
     if (finishedLog.empty()) {
         std::cout << "(none)\n";
@@ -107,6 +217,194 @@ void Scheduler::printLog() const {
 }
 
 
+int Scheduler::addRecurringTask(const std::string& description, int estimate, long long intervalSeconds,
+                                CatchUpPolicy policy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    RecurringTask r(nextRecurrenceId, description, estimate, intervalSeconds, currentTime(), policy);
+    int id = insertRecurringLocked(r);
+    releaseDueTasksLocked(currentTime());
+    return id;
+}
+
+
+int Scheduler::addCronTask(const std::string& description, int estimate, const std::string& cronExpr,
+                           CatchUpPolicy policy) {
+    CronExpression cron(cronExpr);
+    std::lock_guard<std::mutex> lock(mutex);
+    RecurringTask r(nextRecurrenceId, description, estimate, cron, currentTime(), policy);
+    return insertRecurringLocked(r);
+}
+
+
+int Scheduler::insertRecurringLocked(RecurringTask task) {
+    int id = nextRecurrenceId++;
+    if (task.nextFire != 0) fireQueue.push({task.nextFire, id});
+    recurringTasks.emplace(id, task);
+    std::cout << "Added recurring task [R#" << id << "].\n";
+    return id;
+}
+
+
+bool Scheduler::removeRecurringTask(int recurrenceId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (recurringTasks.erase(recurrenceId) == 0) {
+        std::cout << "Recurring task [R#" << recurrenceId << "] not found.\n";
+        return false;
+    }
+    std::cout << "Removed recurring task [R#" << recurrenceId << "].\n";
+    return true;
+}
+
+
+void Scheduler::viewRecurringTasks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseDueTasksLocked(currentTime());
+    std::cout << "--- Recurring Tasks (" << recurringTasks.size() << ") ---\n";
+    if (recurringTasks.empty()) {
+        std::cout << "(none)\n";
+        return;
+    }
+    for (const auto& entry : recurringTasks) {
+        std::cout << entry.second.getDetails() << "\n";
+    }
+}
+
+
+int Scheduler::releaseDueTasks(std::time_t now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return releaseDueTasksLocked(now);
+}
+
+
+int Scheduler::releaseDueTasks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return releaseDueTasksLocked(currentTime());
+}
+
+
+int Scheduler::releaseDueTasksLocked(std::time_t now) {
+    int released = 0;
+    while (!fireQueue.empty() && fireQueue.top().first <= now) {
+        FireEntry due = fireQueue.top();
+        fireQueue.pop();
+
+        auto it = recurringTasks.find(due.second);
+        if (it == recurringTasks.end() || it->second.nextFire != due.first) continue; // stale entry
+        RecurringTask& r = it->second;
+
+        // Work out how many fire times have passed and where the schedule resumes.
+        std::time_t following = r.fireAfter(due.first);
+        bool missedMore = following != 0 && following <= now;
+        int runs = 1;
+        if (r.catchUp == CatchUpPolicy::Skip && missedMore) {
+            runs = 0;
+        } else if (r.catchUp == CatchUpPolicy::RunAll) {
+            for (std::time_t f = following; f != 0 && f <= now && runs < kMaxCatchUpRuns; f = r.fireAfter(f)) {
+                ++runs;
+            }
+        }
+
+        std::time_t next = following;
+        if (missedMore) {
+            if (r.kind == RecurrenceKind::Interval) {
+                // Jump straight past now; a jump beyond std::time_t ends the schedule.
+                long long behind = static_cast<long long>(now - due.first) / r.intervalSeconds + 1;
+                long long room = static_cast<long long>(std::numeric_limits<std::time_t>::max() - due.first);
+                next = behind > room / r.intervalSeconds
+                    ? 0 : due.first + static_cast<std::time_t>(behind * r.intervalSeconds);
+            } else {
+                next = r.cron.nextAfter(now);
+            }
+        }
+
+        for (int i = 0; i < runs; ++i) addTaskLocked(r.description, r.estimatedDurationSeconds);
+        released += runs;
+
+        r.nextFire = next;
+        if (next != 0) fireQueue.push({next, r.id});
+    }
+    return released;
+}
+
+
+std::time_t Scheduler::nextRecurringFireTime() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fireQueue.empty() ? 0 : fireQueue.top().first;
+}
+
+
+std::vector<RecurringTask> Scheduler::getRecurringTasks() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<RecurringTask> result;
+    result.reserve(recurringTasks.size());
+    for (const auto& entry : recurringTasks) result.push_back(entry.second);
+    return result;
+}
+
+
+std::vector<Task> Scheduler::searchTasks(const std::string& query, SearchMode mode,
+                                         const SearchFilter& filter, std::size_t limit) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return searchIndex.search(query, mode, filter, limit);
+}
+
+
+double Scheduler::sortValue(const Task& task, SortKey key) {
+    double actual = 0.0;
+    if (task.startTime != 0 && task.finishTime != 0) actual = std::difftime(task.finishTime, task.startTime);
+    switch (key) {
+        case SortKey::Estimate: return task.estimatedDurationSeconds;
+        case SortKey::ActualDuration: return actual;
+        case SortKey::Overrun: return actual / std::max(1, task.estimatedDurationSeconds);
+        case SortKey::FinishTime: return static_cast<double>(task.finishTime);
+    }
+    return 0.0;
+}
+
+
+const OrderedIndex<Scheduler::RankKey>& Scheduler::sortedIndex(SortKey key) const {
+    switch (key) {
+        case SortKey::Estimate: return stagedByEstimate;
+        case SortKey::ActualDuration: return finishedByDuration;
+        case SortKey::Overrun: return finishedByOverrun;
+        case SortKey::FinishTime: return finishedByFinishTime;
+    }
+    return stagedByEstimate;
+}
+
+
+std::vector<Task> Scheduler::getSortedTasks(SortKey key, std::size_t offset, std::size_t limit,
+                                            bool descending) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Task> result;
+    for (const auto& entry : sortedIndex(key).page(offset, limit, descending)) {
+        if (const Task* t = searchIndex.find(entry.second)) result.push_back(*t);
+    }
+    return result;
+}
+
+
+long long Scheduler::getSortedRank(SortKey key, int id, bool descending) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Task* t = searchIndex.find(id);
+    if (!t) return -1;
+    Status expected = key == SortKey::Estimate ? Status::Staged : Status::Finished;
+    if (t->status != expected) return -1;
+
+    const auto& index = sortedIndex(key);
+    RankKey k{sortValue(*t, key), id};
+    std::size_t r = index.rank(k);
+    if (r >= index.size() || index.at(r) != k) return -1;
+    return static_cast<long long>(descending ? index.size() - 1 - r : r);
+}
+
+
+std::size_t Scheduler::getSortedCount(SortKey key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sortedIndex(key).size();
+}
+
+
 Task* Scheduler::findTaskById(int id, std::vector<Task>& list) {
     for (auto& t : list) {
         if (t.id == id) return &t;
@@ -126,26 +424,7 @@ const std::vector<Task>& Scheduler::getFinishedTasks() const {
     return finishedLog;
 }
 
-void Scheduler::logTaskToCSV(const Task& task) {
-    const std::string filename = "finished_tasks.csv";
-    bool fileExists = false;
-    
-    // Check if file exists
-    std::ifstream checkFile(filename);
-    fileExists = checkFile.good();
-    checkFile.close();
-    
-    std::ofstream csvFile(filename, std::ios::app);
-    if (!csvFile) {
-        std::cerr << "Error: Could not open CSV file for logging.\n";
-        return;
-    }
-    
-    // Write header if file is new
-    if (!fileExists) {
-        csvFile << "ID,Description,Estimated Duration (sec),Start Time,Finish Time,Actual Duration (sec)\n";
-    }
-    
+bool Scheduler::logTaskToCSV(const Task& task) {
     // Format timestamps
     auto formatTime = [](std::time_t t) -> std::string {
         if (t == 0) return "N/A";
@@ -173,14 +452,40 @@ void Scheduler::logTaskToCSV(const Task& task) {
         escapedDesc = "\"" + escapedDesc + "\"";
     }
     
-    // Write task data
-    csvFile << task.id << ","
-            << escapedDesc << ","
-            << task.estimatedDurationSeconds << ","
-            << formatTime(task.startTime) << ","
-            << formatTime(task.finishTime) << ","
-            << actualDuration << "\n";
-    
-    csvFile.close();
-    std::cout << "Task logged to " << filename << "\n";
+    // Build the task row
+    std::stringstream row;
+    row << task.id << ","
+        << escapedDesc << ","
+        << task.estimatedDurationSeconds << ","
+        << formatTime(task.startTime) << ","
+        << formatTime(task.finishTime) << ","
+        << actualDuration;
+
+    if (!csvLog.append(row.str(), task.finishTime)) {
+        std::cerr << "Error: Could not open CSV file for logging.\n";
+        return false;
+    }
+    return true;
+}
+
+
+std::time_t Scheduler::csvRowFinishTime(const std::string& row) {
+    // Finish Time is the second-to-last column; the columns after the
+    // (possibly quoted) description never contain commas.
+    std::size_t last = row.rfind(',');
+    if (last == std::string::npos || last == 0) return 0;
+    std::size_t prev = row.rfind(',', last - 1);
+    if (prev == std::string::npos) return 0;
+
+    std::tm tm = {};
+    std::istringstream ss(row.substr(prev + 1, last - prev - 1));
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) return 0;
+    tm.tm_isdst = -1;
+    return std::mktime(&tm);
+}
+
+
+RotatingCsvLog& Scheduler::getCsvLog() {
+    return csvLog;
 }
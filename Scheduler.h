@@ -1,9 +1,37 @@
 #pragma once
 
 #include "Task.h"
+#include "CoTask.h"
+#include "OrderedIndex.h"
+#include "Recurrence.h"
+#include "RotatingCsvLog.h"
+#include "TaskSearchIndex.h"
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <vector>
 #include <string>
 
+class CoExecutor;
+
+/**
+ * @enum SortKey
+ * @brief Orderings maintained by the Scheduler for sorted, paged views.
+ */
+enum class SortKey {
+    /** @brief Staged tasks by estimated duration. */
+    Estimate,
+    /** @brief Finished tasks by actual duration (finish - start). */
+    ActualDuration,
+    /** @brief Finished tasks by actual duration divided by estimate. */
+    Overrun,
+    /** @brief Finished tasks by finish time. */
+    FinishTime
+};
+
 /**
  * @file Scheduler.h
  * @brief Declaration of the Scheduler class which manages Task lifecycle.
@@ -27,6 +55,31 @@ public:
      */
     Scheduler();
 
+    /**
+     * @brief Destroy the Scheduler, stopping its coroutine executor first.
+     */
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * @brief Replace the time source used for timestamps and fire times.
+     *
+     * @param source Callable returning the current time, e.g. a
+     *        VirtualClock; an empty function restores std::time.
+     * @note Install the clock before adding tasks so timestamps stay monotonic.
+     * @return void
+     */
+    void setClock(std::function<std::time_t()> source);
+
+    /**
+     * @brief Read the Scheduler's current time.
+     *
+     * @return std::time_t Time from the clock installed by setClock(), or std::time if none.
+     */
+    std::time_t now() const;
+
     /**
      * @brief Add a new task to the staged list.
      *
@@ -57,10 +110,145 @@ public:
      * @param id Unique task identifier to finish.
      * @note Side-effect: removes the task from `activeTasks`, appends it to
      *       `finishedLog`, and modifies the Task's `status` and `finishTime`.
+     * @note The CSV row is written and flushed while the Scheduler lock is
+     *       held, so concurrent finishes (including coroutine completions)
+     *       are serialized on that write.
      * @return void
      */
     void finishTask(int id);
 
+    /**
+     * @brief Start a staged task without printing anything.
+     *
+     * Used by the CoExecutor, whose worker threads must not write to the console.
+     *
+     * @param id Unique task identifier to start.
+     * @return bool False if the task is not in `stagedTasks`.
+     */
+    bool tryStartTask(int id);
+
+    /**
+     * @brief Finish an active task without printing anything.
+     *
+     * Used by the CoExecutor, whose worker threads must not write to the console.
+     * CSV write errors are still reported on std::cerr.
+     *
+     * @param id Unique task identifier to finish.
+     * @return bool False if the task is not in `activeTasks`.
+     */
+    bool tryFinishTask(int id);
+
+    /**
+     * @brief Add a task whose work is a coroutine and hand it to the executor.
+     *
+     * The task is staged immediately, becomes Active when the executor first
+     * resumes the coroutine, and Finished when the coroutine body returns.
+     *
+     * @param description Human-readable description of the task.
+     * @param estimate Estimated duration in seconds.
+     * @param body Coroutine implementing the task; ownership is transferred.
+     * @note Side-effect: starts the executor on first use (see getExecutor()).
+     * @return int Id assigned to the new task.
+     */
+    int spawnTask(const std::string& description, int estimate, CoTask body);
+
+    /**
+     * @brief Get the executor that runs coroutine tasks, creating it on first use.
+     *
+     * @note The executor starts one worker per hardware thread.
+     * @return CoExecutor& Scheduler-owned executor.
+     */
+    CoExecutor& getExecutor();
+
+    /**
+     * @brief Check whether a task exists and has not finished yet.
+     *
+     * @param id Task id.
+     * @return bool True if the task is Staged or Active; false if it is
+     *         Finished or no task has this id.
+     */
+    bool isTaskPending(int id) const;
+
+    /**
+     * @brief Register a task that repeats at a fixed interval.
+     *
+     * @param description Description given to every run.
+     * @param estimate Estimated duration in seconds for every run.
+     * @param intervalSeconds Seconds between runs (must be positive).
+     * @param policy What to do with runs missed while nothing released them.
+     * @note The first run is due immediately. Runs are staged lazily by
+     *       releaseDueTasks(), which every public operation calls first.
+     * @throws std::invalid_argument If @p intervalSeconds is not positive.
+     * @return int Recurrence id (separate from task ids).
+     */
+    int addRecurringTask(const std::string& description, int estimate, long long intervalSeconds,
+                         CatchUpPolicy policy = CatchUpPolicy::RunOnce);
+
+    /**
+     * @brief Register a task that repeats on a cron schedule.
+     *
+     * @param description Description given to every run.
+     * @param estimate Estimated duration in seconds for every run.
+     * @param cronExpr Five-field cron expression (see CronExpression).
+     * @param policy What to do with runs missed while nothing released them.
+     * @throws std::invalid_argument If @p cronExpr is malformed or never matches.
+     * @return int Recurrence id (separate from task ids).
+     */
+    int addCronTask(const std::string& description, int estimate, const std::string& cronExpr,
+                    CatchUpPolicy policy = CatchUpPolicy::RunOnce);
+
+    /**
+     * @brief Stop a recurring task from producing further runs.
+     *
+     * @param recurrenceId Id returned by addRecurringTask()/addCronTask().
+     * @note Runs already staged are not affected.
+     * @return bool False if no recurring task has this id.
+     */
+    bool removeRecurringTask(int recurrenceId);
+
+    /**
+     * @brief Print all recurring task definitions to standard output.
+     *
+     * @return void
+     */
+    void viewRecurringTasks();
+
+    /**
+     * @brief Stage a run for every recurring task due at or before @p now.
+     *
+     * @details Due definitions are popped from a min-heap keyed by next fire
+     *          time, so each fire costs O(log n) in the number of definitions
+     *          and nothing is scanned while no fire time has passed.
+     *
+     * @param now Reference time.
+     * @return int Number of task runs staged.
+     */
+    int releaseDueTasks(std::time_t now);
+
+    /**
+     * @brief Stage recurring runs due at the Scheduler's current time.
+     *
+     * @return int Number of task runs staged.
+     */
+    int releaseDueTasks();
+
+    /**
+     * @brief Earliest time at which a recurring task may come due.
+     *
+     * @note Intended for callers that want to sleep until the next fire
+     *       instead of polling. May be earlier than the true next fire time
+     *       after a definition was removed, never later.
+     * @return std::time_t Next fire time, or 0 if there are no recurring tasks.
+     */
+    std::time_t nextRecurringFireTime() const;
+
+    /**
+     * @brief Get a snapshot of the recurring task definitions ordered by id.
+     *
+     * @return std::vector<RecurringTask> Copy of all definitions.
+     */
+    std::vector<RecurringTask> getRecurringTasks() const;
+
     /**
      * @brief Print all staged tasks to standard output.
      *
@@ -99,9 +287,71 @@ public:
      */
     Task* findTaskById(int id, std::vector<Task>& list);
 
+    /**
+     * @brief Search every task (staged, active and finished) by description.
+     *
+     * @details Backed by a trigram index that is updated as tasks are added,
+     *          started and finished, so searches do not rescan descriptions.
+     *
+     * @param query Text to look for (case-insensitive).
+     * @param mode Substring or prefix matching.
+     * @param filter Status and time restrictions.
+     * @param limit Maximum number of results (0 means no limit).
+     * @return std::vector<Task> Copies of matching tasks, newest first.
+     */
+    std::vector<Task> searchTasks(const std::string& query, SearchMode mode = SearchMode::Substring,
+                                  const SearchFilter& filter = SearchFilter(), std::size_t limit = 100) const;
+
+    /**
+     * @brief Get one page of a sorted view.
+     *
+     * @details Each SortKey is backed by an order-statistic tree that is
+     *          updated as tasks are added, started and finished, so a page
+     *          costs O(log n + limit) and nothing is re-sorted on render.
+     *          Ties are broken by task id.
+     *
+     * @param key Ordering (and with it the list: staged for Estimate,
+     *        finished for the others).
+     * @param offset Number of tasks to skip.
+     * @param limit Maximum number of tasks to return.
+     * @param descending Largest first when true.
+     * @return std::vector<Task> Copies of the tasks on the page.
+     */
+    std::vector<Task> getSortedTasks(SortKey key, std::size_t offset, std::size_t limit,
+                                     bool descending = true) const;
+
+    /**
+     * @brief Position of a task within a sorted view.
+     *
+     * @param key Ordering to look in.
+     * @param id Task id.
+     * @param descending Count from the largest when true.
+     * @return long long Zero-based position, or -1 if the task is not in that view.
+     */
+    long long getSortedRank(SortKey key, int id, bool descending = true) const;
+
+    /**
+     * @brief Number of tasks in a sorted view.
+     *
+     * @param key Ordering to count.
+     * @return std::size_t Task count.
+     */
+    std::size_t getSortedCount(SortKey key) const;
+
+    /**
+     * @brief Get the finished-task CSV log.
+     *
+     * @details Use it to change the rotation policy, list the segment
+     *        manifest, or force a rotation.
+     * @return RotatingCsvLog& Scheduler-owned log writer.
+     */
+    RotatingCsvLog& getCsvLog();
+
     /**
      * @brief Get the staged tasks list.
      *
+     * @note The list accessors are not synchronized; call them only while no
+     *       coroutine tasks are running (e.g. after CoExecutor::waitIdle()).
      * @return const std::vector<Task>& Reference to staged tasks.
      */
     const std::vector<Task>& getStagedTasks() const;
@@ -125,10 +375,50 @@ private:
      * @brief Log a finished task to CSV file.
      *
      * @param task The completed task to log.
-     * @note Appends task data to finished_tasks.csv in the current directory.
-     * @return void
+     * @note Appends task data to finished_tasks.csv in the current directory,
+     *       which is rotated into compressed segments (see RotatingCsvLog).
+     * @return bool False if the row could not be written (reported on std::cerr).
+     */
+    bool logTaskToCSV(const Task& task);
+
+    /** @brief Parse the Finish Time column of a row written by logTaskToCSV(). */
+    static std::time_t csvRowFinishTime(const std::string& row);
+
+    /** @brief Read the installed clock, or std::time if none is set. */
+    std::time_t currentTime() const;
+
+    /** @brief Unsynchronized body of startTask(); caller holds `mutex`. */
+    bool startTaskLocked(int id);
+
+    /**
+     * @brief Unsynchronized body of finishTask(); caller holds `mutex`.
+     * @param logged Set to whether the CSV row was written.
      */
-    void logTaskToCSV(const Task& task);
+    bool finishTaskLocked(int id, bool& logged);
+
+    /** @brief Unsynchronized body of addTask(); caller holds `mutex`. */
+    int addTaskLocked(const std::string& description, int estimate);
+
+    /** @brief Unsynchronized body of releaseDueTasks(); caller holds `mutex`. */
+    int releaseDueTasksLocked(std::time_t now);
+
+    /** @brief Store a new recurring definition and queue its first fire time. */
+    int insertRecurringLocked(RecurringTask task);
+
+    /** @brief Sorted-view entry: (sort value, task id). */
+    using RankKey = std::pair<double, int>;
+
+    /** @brief Sort value of @p task under @p key. */
+    static double sortValue(const Task& task, SortKey key);
+
+    /** @brief Order-statistic tree backing @p key. */
+    const OrderedIndex<RankKey>& sortedIndex(SortKey key) const;
+
+    /** @brief Heap entry: (fire time, recurrence id), earliest on top. */
+    using FireEntry = std::pair<std::time_t, int>;
+
+    /** @brief Upper bound on runs staged at once under CatchUpPolicy::RunAll. */
+    static constexpr int kMaxCatchUpRuns = 100;
 
     /** @brief Tasks waiting to be started. */
     std::vector<Task> stagedTasks;
@@ -141,4 +431,39 @@ private:
 
     /** @brief Internal counter to generate unique ids. */
     int nextId;
+
+    /** @brief Description index over every task ever added. */
+    TaskSearchIndex searchIndex;
+
+    /** @brief Sorted views, one per SortKey. */
+    OrderedIndex<RankKey> stagedByEstimate;
+    OrderedIndex<RankKey> finishedByDuration;
+    OrderedIndex<RankKey> finishedByOverrun;
+    OrderedIndex<RankKey> finishedByFinishTime;
+
+    /** @brief Recurring task definitions keyed by recurrence id. */
+    std::map<int, RecurringTask> recurringTasks;
+
+    /**
+     * @brief Min-heap of next fire times.
+     *
+     * @note Entries for removed or rescheduled definitions are left in place
+     *       and discarded when they reach the top.
+     */
+    std::priority_queue<FireEntry, std::vector<FireEntry>, std::greater<FireEntry>> fireQueue;
+
+    /** @brief Internal counter to generate unique recurrence ids. */
+    int nextRecurrenceId;
+
+    /** @brief Rotating writer behind logTaskToCSV(). */
+    RotatingCsvLog csvLog;
+
+    /** @brief Time source; empty means std::time. */
+    std::function<std::time_t()> clock;
+
+    /** @brief Guards the task lists; coroutine tasks transition on worker threads. */
+    mutable std::mutex mutex;
+
+    /** @brief Executor for coroutine tasks, created lazily by getExecutor(). */
+    std::unique_ptr<CoExecutor> executor;
 };
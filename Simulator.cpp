@@ -0,0 +1,188 @@
+#include "Simulator.h"
+#include "Scheduler.h"
+#include "VirtualClock.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <sstream>
+#include <iomanip>
+
+/**
+ * @file Simulator.cpp
+ * @brief Implementation of the discrete-event Simulator.
+ */
+
+namespace {
+
+/**
+ * @brief Nearest-rank value at quantile @p q of @p values (reorders the vector).
+ *
+ * @details The smallest value with at least q*n values at or below it, so a
+ *          high percentile of a small sample is never below its true tail.
+ */
+long long quantile(std::vector<long long>& values, double q) {
+    if (values.empty()) return 0;
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())));
+    std::size_t k = std::min(values.size(), std::max<std::size_t>(rank, 1)) - 1;
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+std::string policyName(QueuePolicy p) {
+    switch (p) {
+        case QueuePolicy::Fifo: return "FIFO";
+        case QueuePolicy::ShortestFirst: return "Shortest first";
+        case QueuePolicy::LongestFirst: return "Longest first";
+    }
+    return "Unknown";
+}
+
+} // namespace
+
+std::string SimulationReport::getDetails() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << policyName(policy) << " | Workers: " << workers << " | Jobs: " << jobs
+       << " | Makespan: " << makespan << " sec"
+       << " | Wait mean/p50/p90/p99/max: " << meanWait << "/" << p50Wait << "/" << p90Wait
+       << "/" << p99Wait << "/" << maxWait << " sec"
+       << " | Utilization: " << utilization * 100.0 << "%";
+    return ss.str();
+}
+
+std::vector<SimJob> Simulator::currentWorkload(const Scheduler& scheduler, std::time_t now) {
+    std::vector<SimJob> jobs;
+    jobs.reserve(scheduler.getActiveTasks().size() + scheduler.getStagedTasks().size());
+    for (const auto& t : scheduler.getActiveTasks()) {
+        long long elapsed = t.startTime != 0 ? static_cast<long long>(std::difftime(now, t.startTime)) : 0;
+        jobs.push_back({0, std::max(0LL, t.estimatedDurationSeconds - elapsed)});
+    }
+    for (const auto& t : scheduler.getStagedTasks()) {
+        jobs.push_back({0, std::max(0, t.estimatedDurationSeconds)});
+    }
+    return jobs;
+}
+
+std::vector<SimJob> Simulator::recordedWorkload(const Scheduler& scheduler) {
+    std::vector<SimJob> jobs;
+    const auto& log = scheduler.getFinishedTasks();
+    std::time_t origin = 0;
+    for (const auto& t : log) {
+        if (t.startTime != 0 && (origin == 0 || t.startTime < origin)) origin = t.startTime;
+    }
+    jobs.reserve(log.size());
+    for (const auto& t : log) {
+        if (t.startTime == 0 || t.finishTime == 0) continue;
+        // A clock that went backwards can record a finish before the start.
+        jobs.push_back({static_cast<long long>(std::difftime(t.startTime, origin)),
+                        std::max(0LL, static_cast<long long>(std::difftime(t.finishTime, t.startTime)))});
+    }
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const SimJob& a, const SimJob& b) { return a.arrival < b.arrival; });
+    return jobs;
+}
+
+SimulationReport Simulator::run(const std::vector<SimJob>& input, int workers, QueuePolicy policy) {
+    if (workers < 1) workers = 1;
+
+    std::vector<SimJob> jobs = input;
+    // A negative duration would finish a job before it starts and skew waits
+    // and utilization; treat it as instantaneous.
+    for (auto& job : jobs) job.duration = std::max(0LL, job.duration);
+    if (!std::is_sorted(jobs.begin(), jobs.end(),
+                        [](const SimJob& a, const SimJob& b) { return a.arrival < b.arrival; })) {
+        std::stable_sort(jobs.begin(), jobs.end(),
+                         [](const SimJob& a, const SimJob& b) { return a.arrival < b.arrival; });
+    }
+
+    SimulationReport report{policy, workers, jobs.size(), 0, 0.0, 0, 0, 0, 0, 0.0};
+    if (jobs.empty()) return report;
+
+    const long long start = jobs.front().arrival;
+    VirtualClock clock(static_cast<std::time_t>(start));
+
+    // Waiting jobs. FIFO is served straight from the arrival-ordered array
+    // (`fifoHead`..`admitted`); the other policies use a heap of
+    // (signed duration, index) so ties fall back to arrival order.
+    using Key = std::pair<long long, std::size_t>;
+    std::priority_queue<Key, std::vector<Key>, std::greater<Key>> waiting;
+    std::size_t fifoHead = 0;
+
+    // Completion times of busy workers, earliest on top.
+    std::priority_queue<long long, std::vector<long long>, std::greater<long long>> busy;
+
+    std::vector<long long> waits;
+    waits.reserve(jobs.size());
+    long long busySeconds = 0;
+    long long waitSum = 0;
+    long long lastFinish = start;
+    std::size_t admitted = 0;
+    int idle = workers;
+
+    while (admitted < jobs.size() || fifoHead < admitted || !waiting.empty() || !busy.empty()) {
+        const long long now = static_cast<long long>(clock.now());
+
+        // Free workers whose job has completed.
+        while (!busy.empty() && busy.top() <= now) {
+            busy.pop();
+            ++idle;
+        }
+
+        // Admit arrivals.
+        for (; admitted < jobs.size() && jobs[admitted].arrival <= now; ++admitted) {
+            if (policy == QueuePolicy::ShortestFirst) waiting.push({jobs[admitted].duration, admitted});
+            else if (policy == QueuePolicy::LongestFirst) waiting.push({-jobs[admitted].duration, admitted});
+        }
+
+        // Hand waiting jobs to idle workers.
+        while (idle > 0) {
+            std::size_t idx;
+            if (policy == QueuePolicy::Fifo) {
+                if (fifoHead == admitted) break;
+                idx = fifoHead++;
+            } else {
+                if (waiting.empty()) break;
+                idx = waiting.top().second;
+                waiting.pop();
+            }
+            const SimJob& job = jobs[idx];
+            long long wait = now - job.arrival;
+            waits.push_back(wait);
+            waitSum += wait;
+            busySeconds += job.duration;
+            busy.push(now + job.duration);
+            lastFinish = std::max(lastFinish, now + job.duration);
+            --idle;
+        }
+
+        // Jump to the next event: a completion or an arrival.
+        long long next = -1;
+        if (!busy.empty()) next = busy.top();
+        if (admitted < jobs.size() && (next < 0 || jobs[admitted].arrival < next)) next = jobs[admitted].arrival;
+        if (next < 0) break;
+        clock.advanceTo(static_cast<std::time_t>(next));
+    }
+
+    report.makespan = lastFinish - start;
+    report.meanWait = static_cast<double>(waitSum) / static_cast<double>(waits.size());
+    report.maxWait = *std::max_element(waits.begin(), waits.end());
+    report.p50Wait = quantile(waits, 0.50);
+    report.p90Wait = quantile(waits, 0.90);
+    report.p99Wait = quantile(waits, 0.99);
+    if (report.makespan > 0) {
+        report.utilization = static_cast<double>(busySeconds) /
+                             (static_cast<double>(report.makespan) * workers);
+    }
+    return report;
+}
+
+std::vector<SimulationReport> Simulator::sweep(const std::vector<SimJob>& jobs, int maxWorkers) {
+    std::vector<SimulationReport> reports;
+    for (int w = 1; w <= std::max(1, maxWorkers); ++w) {
+        for (QueuePolicy p : {QueuePolicy::Fifo, QueuePolicy::ShortestFirst, QueuePolicy::LongestFirst}) {
+            reports.push_back(run(jobs, w, p));
+        }
+    }
+    return reports;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @file Simulator.h
+ * @brief Discrete-event simulation of a task backlog for capacity planning.
+ */
+
+class Scheduler;
+
+/**
+ * @enum QueuePolicy
+ * @brief Order in which simulated workers pick waiting jobs.
+ */
+enum class QueuePolicy {
+    /** @brief First come, first served. */
+    Fifo,
+    /** @brief Shortest job first (ties in arrival order). */
+    ShortestFirst,
+    /** @brief Longest job first (ties in arrival order). */
+    LongestFirst
+};
+
+/**
+ * @struct SimJob
+ * @brief One unit of simulated work.
+ */
+struct SimJob {
+    /** @brief Time the job becomes available, in seconds from the start of the run. */
+    long long arrival;
+
+    /** @brief Time a worker needs to complete the job, in seconds (negative values are run as 0). */
+    long long duration;
+};
+
+/**
+ * @struct SimulationReport
+ * @brief Results of simulating one workload on one configuration.
+ */
+struct SimulationReport {
+    /** @brief Queue policy that was simulated. */
+    QueuePolicy policy;
+
+    /** @brief Number of simulated workers. */
+    int workers;
+
+    /** @brief Number of jobs in the workload. */
+    std::size_t jobs;
+
+    /** @brief Time from the first arrival until the last job completes, in seconds. */
+    long long makespan;
+
+    /** @brief Mean time jobs spent waiting for a worker, in seconds. */
+    double meanWait;
+
+    /** @brief Median wait in seconds (percentiles use the nearest-rank method). */
+    long long p50Wait;
+
+    /** @brief 90th percentile wait in seconds. */
+    long long p90Wait;
+
+    /** @brief 99th percentile wait in seconds. */
+    long long p99Wait;
+
+    /** @brief Longest wait in seconds. */
+    long long maxWait;
+
+    /** @brief Busy worker-seconds divided by available worker-seconds (0..1). */
+    double utilization;
+
+    /**
+     * @brief Return a human readable one-line summary.
+     *
+     * @return std::string Formatted report for display.
+     */
+    std::string getDetails() const;
+};
+
+/**
+ * @class Simulator
+ * @brief Replays a workload on N simulated workers under a virtual clock.
+ *
+ * @details The simulation is event driven: the VirtualClock jumps straight
+ *          from one arrival or completion to the next, so runtime depends
+ *          only on the number of jobs (O(n log n)), never on simulated time.
+ *          The Scheduler itself is not touched; workloads are built from its
+ *          lists and simulated on plain arrays.
+ */
+class Simulator {
+public:
+    /**
+     * @brief Build a workload from the Scheduler's current backlog.
+     *
+     * @details Every staged task becomes a job arriving at time 0 that takes
+     *          its estimate. Active tasks are included with the part of their
+     *          estimate that has not elapsed yet at @p now.
+     *
+     * @param scheduler Scheduler to read (must not be mutated concurrently).
+     * @param now Reference time for active tasks.
+     * @return std::vector<SimJob> Jobs in arrival order.
+     */
+    static std::vector<SimJob> currentWorkload(const Scheduler& scheduler, std::time_t now);
+
+    /**
+     * @brief Build a workload from the Scheduler's finished log.
+     *
+     * @details Each finished task arrives at its recorded start time
+     *          (relative to the earliest one) and takes its actual duration.
+     *
+     * @param scheduler Scheduler to read (must not be mutated concurrently).
+     * @return std::vector<SimJob> Jobs in arrival order.
+     */
+    static std::vector<SimJob> recordedWorkload(const Scheduler& scheduler);
+
+    /**
+     * @brief Simulate @p jobs on @p workers workers.
+     *
+     * @param jobs Workload; need not be sorted. Negative durations are clamped to 0.
+     * @param workers Number of simulated workers (at least 1 is used).
+     * @param policy Order in which waiting jobs are picked.
+     * @return SimulationReport Makespan, wait distribution and utilization.
+     */
+    static SimulationReport run(const std::vector<SimJob>& jobs, int workers, QueuePolicy policy);
+
+    /**
+     * @brief Simulate every combination of 1..@p maxWorkers workers and queue policy.
+     *
+     * @param jobs Workload to replay.
+     * @param maxWorkers Largest worker count to try.
+     * @return std::vector<SimulationReport> One report per configuration.
+     */
+    static std::vector<SimulationReport> sweep(const std::vector<SimJob>& jobs, int maxWorkers);
+};
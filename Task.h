@@ -48,20 +48,22 @@ public:
     /**
      * @brief Mark the task as active and record start time.
      *
+     * @param now Start time to record (defaults to std::time(nullptr)).
      * @note Side-effect: sets `status` to Status::Active and records
-     *       `startTime` with std::time(nullptr).
+     *       `startTime`.
      * @return void
      */
-    void markActive();
+    void markActive(std::time_t now = std::time(nullptr));
 
     /**
      * @brief Mark the task as finished and record finish time.
      *
+     * @param now Finish time to record (defaults to std::time(nullptr)).
      * @note Side-effect: sets `status` to Status::Finished and records
-     *       `finishTime` with std::time(nullptr).
+     *       `finishTime`.
      * @return void
      */
-    void markFinished();
+    void markFinished(std::time_t now = std::time(nullptr));
 
     /**
      * @brief Return a human readable detail string for the task.
@@ -99,14 +101,14 @@ public:
 inline Task::Task(int id_, const std::string& description_, int estimate)
     : id(id_), description(description_), status(Status::Staged), startTime(0), finishTime(0), estimatedDurationSeconds(estimate) {}
 
-inline void Task::markActive() {
+inline void Task::markActive(std::time_t now) {
     status = Status::Active;
-    startTime = std::time(nullptr);
+    startTime = now;
 }
 
-inline void Task::markFinished() {
+inline void Task::markFinished(std::time_t now) {
     status = Status::Finished;
-    finishTime = std::time(nullptr);
+    finishTime = now;
 }
 
 inline std::string Task::getDetails() const {
@@ -0,0 +1,152 @@
+#include "TaskSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+
+/**
+ * @file TaskSearchIndex.cpp
+ * @brief Implementation of the trigram TaskSearchIndex.
+ */
+
+namespace {
+
+/** @brief Marker placed before each description so prefixes have their own trigrams. */
+const char kStartMarker = '\x01';
+
+std::string toLower(const std::string& s) {
+    std::string out = s;
+    for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+bool equalsIgnoreCase(char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) == static_cast<unsigned char>(b);
+}
+
+} // namespace
+
+std::uint32_t TaskSearchIndex::key(unsigned char a, unsigned char b, unsigned char c) {
+    return (static_cast<std::uint32_t>(a) << 16) | (static_cast<std::uint32_t>(b) << 8) | c;
+}
+
+std::uint32_t TaskSearchIndex::key(unsigned char a, unsigned char b) {
+    // Bit 24 keeps bigram keys apart from every trigram key.
+    return (1u << 24) | (static_cast<std::uint32_t>(a) << 8) | b;
+}
+
+std::vector<std::uint32_t> TaskSearchIndex::trigrams(const std::string& text) {
+    std::vector<std::uint32_t> keys;
+    for (std::size_t i = 0; i + 3 <= text.size(); ++i) {
+        keys.push_back(key(text[i], text[i + 1], text[i + 2]));
+    }
+    return keys;
+}
+
+std::vector<std::uint32_t> TaskSearchIndex::bigrams(const std::string& text) {
+    std::vector<std::uint32_t> keys;
+    for (std::size_t i = 0; i + 2 <= text.size(); ++i) {
+        keys.push_back(key(text[i], text[i + 1]));
+    }
+    return keys;
+}
+
+void TaskSearchIndex::add(const Task& task) {
+    if (task.id < 0) return;
+    std::size_t slot = static_cast<std::size_t>(task.id);
+    if (slot >= tasks.size()) {
+        tasks.resize(slot + 1, Task(0, "", 0));
+        present.resize(slot + 1, false);
+    }
+    if (present[slot]) return;
+    tasks[slot] = task;
+    present[slot] = true;
+    ++count;
+
+    const std::string text = kStartMarker + toLower(task.description);
+    for (const auto& keys : {trigrams(text), bigrams(text)}) {
+        for (std::uint32_t k : keys) {
+            auto& list = postings[k];
+            if (list.empty() || list.back() != task.id) list.push_back(task.id);
+        }
+    }
+}
+
+void TaskSearchIndex::update(const Task& task) {
+    if (task.id < 0) return;
+    std::size_t slot = static_cast<std::size_t>(task.id);
+    if (slot >= tasks.size() || !present[slot]) return;
+    tasks[slot].status = task.status;
+    tasks[slot].startTime = task.startTime;
+    tasks[slot].finishTime = task.finishTime;
+}
+
+const Task* TaskSearchIndex::find(int id) const {
+    if (id < 0 || static_cast<std::size_t>(id) >= tasks.size() || !present[id]) return nullptr;
+    return &tasks[id];
+}
+
+bool TaskSearchIndex::matches(const Task& task, const std::string& lowerQuery, SearchMode mode,
+                              const SearchFilter& filter) {
+    switch (task.status) {
+        case Status::Staged: if (!filter.includeStaged) return false; break;
+        case Status::Active: if (!filter.includeActive) return false; break;
+        case Status::Finished: if (!filter.includeFinished) return false; break;
+    }
+
+    auto outside = [](std::time_t t, std::time_t after, std::time_t before) {
+        if (after == 0 && before == 0) return false;
+        if (t == 0) return true;
+        return (after != 0 && t < after) || (before != 0 && t > before);
+    };
+    if (outside(task.startTime, filter.startedAfter, filter.startedBefore)) return false;
+    if (outside(task.finishTime, filter.finishedAfter, filter.finishedBefore)) return false;
+
+    const std::string& d = task.description;
+    if (mode == SearchMode::Prefix) {
+        return d.size() >= lowerQuery.size() &&
+               std::equal(lowerQuery.begin(), lowerQuery.end(), d.begin(),
+                          [](char q, char c) { return equalsIgnoreCase(c, q); });
+    }
+    return std::search(d.begin(), d.end(), lowerQuery.begin(), lowerQuery.end(), equalsIgnoreCase) != d.end();
+}
+
+std::vector<Task> TaskSearchIndex::search(const std::string& query, SearchMode mode,
+                                          const SearchFilter& filter, std::size_t limit) const {
+    std::vector<Task> results;
+    const std::string lowerQuery = toLower(query);
+    auto full = [&] { return limit != 0 && results.size() >= limit; };
+
+    const std::string text = mode == SearchMode::Prefix ? kStartMarker + lowerQuery : lowerQuery;
+    std::vector<std::uint32_t> keys = text.size() >= 3 ? trigrams(text) : bigrams(text);
+
+    if (keys.empty()) {
+        // Too short to use the index: scan newest first.
+        for (std::size_t slot = tasks.size(); slot-- > 0 && !full();) {
+            if (present[slot] && matches(tasks[slot], lowerQuery, mode, filter)) results.push_back(tasks[slot]);
+        }
+        return results;
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<const std::vector<int>*> lists;
+    for (std::uint32_t k : keys) {
+        auto it = postings.find(k);
+        if (it == postings.end()) return results;
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+    // Walk the rarest trigram's ids newest first and probe the others.
+    const std::vector<int>& rarest = *lists.front();
+    for (auto it = rarest.rbegin(); it != rarest.rend() && !full(); ++it) {
+        int id = *it;
+        bool inAll = true;
+        for (std::size_t i = 1; i < lists.size() && inAll; ++i) {
+            inAll = std::binary_search(lists[i]->begin(), lists[i]->end(), id);
+        }
+        if (inAll && matches(tasks[id], lowerQuery, mode, filter)) results.push_back(tasks[id]);
+    }
+    return results;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Task.h"
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file TaskSearchIndex.h
+ * @brief Trigram inverted index over task descriptions.
+ */
+
+/**
+ * @enum SearchMode
+ * @brief How a search query is matched against descriptions.
+ */
+enum class SearchMode {
+    /** @brief Query may appear anywhere in the description. */
+    Substring,
+    /** @brief Description must start with the query. */
+    Prefix
+};
+
+/**
+ * @struct SearchFilter
+ * @brief Restrictions applied to search results in addition to the text match.
+ *
+ * @note Time bounds are inclusive; 0 leaves a bound open. A task with no
+ *       start (finish) time never satisfies a start (finish) bound.
+ */
+struct SearchFilter {
+    bool includeStaged = true;
+    bool includeActive = true;
+    bool includeFinished = true;
+    std::time_t startedAfter = 0;
+    std::time_t startedBefore = 0;
+    std::time_t finishedAfter = 0;
+    std::time_t finishedBefore = 0;
+};
+
+/**
+ * @class TaskSearchIndex
+ * @brief Case-insensitive substring and prefix search over every task.
+ *
+ * @details Each description is broken into overlapping three-character
+ *          windows (trigrams); for every trigram the index keeps the sorted
+ *          list of task ids whose description contains it. A query is
+ *          answered by intersecting the posting lists of its trigrams,
+ *          starting from the shortest, and confirming the few surviving
+ *          candidates with a direct comparison. Bigrams are indexed as
+ *          well so two-character queries are answered the same way.
+ *          Descriptions are prefixed with a start marker before indexing so
+ *          prefix queries are just queries anchored on that marker.
+ *
+ *          The index keeps its own copy of each Task so results can be
+ *          returned without searching the Scheduler's lists. Task ids are
+ *          assumed to be small and increasing, as the Scheduler issues them.
+ */
+class TaskSearchIndex {
+public:
+    /**
+     * @brief Index a newly created task.
+     *
+     * @param task Task to add; its id must not already be indexed.
+     * @return void
+     */
+    void add(const Task& task);
+
+    /**
+     * @brief Refresh the status and timestamps of an indexed task.
+     *
+     * @param task Task carrying the new state; ignored if it is not indexed.
+     * @note Descriptions never change, so no postings are touched.
+     * @return void
+     */
+    void update(const Task& task);
+
+    /**
+     * @brief Find tasks whose description matches @p query.
+     *
+     * @param query Text to look for (case-insensitive).
+     * @param mode Substring or prefix matching.
+     * @param filter Status and time restrictions.
+     * @param limit Maximum number of results (0 means no limit).
+     * @return std::vector<Task> Matching tasks, newest (highest id) first.
+     *
+     * @note Empty and single-character substring queries have nothing to
+     *       look up and fall back to scanning tasks newest first until
+     *       @p limit results are found.
+     */
+    std::vector<Task> search(const std::string& query, SearchMode mode,
+                             const SearchFilter& filter, std::size_t limit) const;
+
+    /**
+     * @brief Look up the indexed copy of a task by id.
+     *
+     * @param id Task id.
+     * @return const Task* Current copy of the task, or nullptr if not indexed.
+     */
+    const Task* find(int id) const;
+
+    /**
+     * @brief Number of indexed tasks.
+     *
+     * @return std::size_t Task count.
+     */
+    std::size_t size() const { return count; }
+
+private:
+    /** @brief Pack three lower-cased bytes into a posting-list key. */
+    static std::uint32_t key(unsigned char a, unsigned char b, unsigned char c);
+
+    /** @brief Pack two lower-cased bytes into a posting-list key. */
+    static std::uint32_t key(unsigned char a, unsigned char b);
+
+    /** @brief Trigram keys of @p text (with duplicates). */
+    static std::vector<std::uint32_t> trigrams(const std::string& text);
+
+    /** @brief Bigram keys of @p text (with duplicates). */
+    static std::vector<std::uint32_t> bigrams(const std::string& text);
+
+    /** @brief Does @p task satisfy the text match and @p filter? */
+    static bool matches(const Task& task, const std::string& lowerQuery, SearchMode mode,
+                        const SearchFilter& filter);
+
+    /** @brief Task copies indexed by task id; `present` marks used slots. */
+    std::vector<Task> tasks;
+    std::vector<bool> present;
+
+    /** @brief Trigram or bigram key -> ascending ids of tasks containing it. */
+    std::unordered_map<std::uint32_t, std::vector<int>> postings;
+
+    /** @brief Number of indexed tasks. */
+    std::size_t count = 0;
+};
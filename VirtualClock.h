@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ctime>
+
+/**
+ * @file VirtualClock.h
+ * @brief Manually advanced clock used in place of std::time for simulation.
+ */
+
+/**
+ * @class VirtualClock
+ * @brief A clock whose time only moves when the owner advances it.
+ *
+ * @details Install it on a Scheduler with
+ *          `scheduler.setClock([&clock] { return clock.now(); })` to drive
+ *          timestamps and recurring fire times deterministically. The
+ *          Simulator uses one internally to step between events.
+ */
+class VirtualClock {
+public:
+    /**
+     * @brief Construct a clock reading @p start.
+     *
+     * @param start Initial time (seconds, same scale as std::time_t).
+     */
+    explicit VirtualClock(std::time_t start = 0);
+
+    /**
+     * @brief Get the current virtual time.
+     *
+     * @return std::time_t Current time.
+     */
+    std::time_t now() const;
+
+    /**
+     * @brief Jump forward to @p t.
+     *
+     * @param t Target time; ignored if earlier than now() so time never runs backwards.
+     * @return void
+     */
+    void advanceTo(std::time_t t);
+
+    /**
+     * @brief Move forward by @p seconds.
+     *
+     * @param seconds Non-negative number of seconds to advance.
+     * @return void
+     */
+    void advanceBy(long long seconds);
+
+private:
+    /** @brief Current virtual time. */
+    std::time_t current;
+};
+
+// -------------------------
+// Inline implementations
+// -------------------------
+
+inline VirtualClock::VirtualClock(std::time_t start) : current(start) {}
+
+inline std::time_t VirtualClock::now() const {
+    return current;
+}
+
+inline void VirtualClock::advanceTo(std::time_t t) {
+    if (t > current) current = t;
+}
+
+inline void VirtualClock::advanceBy(long long seconds) {
+    if (seconds > 0) current += static_cast<std::time_t>(seconds);
+}
@@ -1,7 +1,9 @@
 #include "Scheduler.h"
+#include "Simulator.h"
 #include <iostream>
 #include <string>
 #include <limits>
+#include <stdexcept>
 
 using namespace std;
 
@@ -24,6 +26,9 @@ int main() {
     bool running = true;
 
     while (running) {
+        // Stage any recurring runs that came due while waiting for input.
+        scheduler.releaseDueTasks();
+
         std::cout << "\n=== Simple Job Scheduler ===\n";
         std::cout << "1) Add Task\n";
         std::cout << "2) Start Task (by ID)\n";
@@ -31,6 +36,12 @@ int main() {
         std::cout << "4) View Staged Tasks\n";
         std::cout << "5) View Active Tasks\n";
         std::cout << "6) View Finished Log\n";
+        std::cout << "7) Add Recurring Task\n";
+        std::cout << "8) View Recurring Tasks\n";
+        std::cout << "9) Remove Recurring Task (by ID)\n";
+        std::cout << "10) Simulate Worker Capacity\n";
+        std::cout << "11) Search Tasks\n";
+        std::cout << "12) Sorted View\n";
         std::cout << "0) Exit\n";
         std::cout << "Choose an option: ";
 
@@ -78,6 +89,135 @@ int main() {
             case 4: scheduler.viewStagedTasks(); break;
             case 5: scheduler.viewActiveTasks(); break;
             case 6: scheduler.printLog(); break;
+            case 7: {
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::string desc, schedule;
+                int estimate = 0, policy = 0;
+                std::cout << "Enter task description: ";
+                std::getline(std::cin, desc);
+                std::cout << "Schedule (interval in seconds, or cron e.g. \"0 9 * * 1-5\"): ";
+                std::getline(std::cin, schedule);
+                std::cout << "Estimated duration (seconds): ";
+                if (!(std::cin >> estimate)) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid estimate. Recurring task not added.\n";
+                    break;
+                }
+                std::cout << "Missed runs (0 = run once, 1 = run all, 2 = skip): ";
+                if (!(std::cin >> policy) || policy < 0 || policy > 2) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid policy. Recurring task not added.\n";
+                    break;
+                }
+                try {
+                    CatchUpPolicy p = static_cast<CatchUpPolicy>(policy);
+                    if (!schedule.empty() && schedule.find_first_not_of("0123456789") == std::string::npos) {
+                        scheduler.addRecurringTask(desc, estimate, std::stoll(schedule), p);
+                    } else {
+                        scheduler.addCronTask(desc, estimate, schedule, p);
+                    }
+                } catch (const std::out_of_range&) {
+                    std::cout << "Invalid schedule: interval is too long\n";
+                } catch (const std::exception& e) {
+                    std::cout << "Invalid schedule: " << e.what() << "\n";
+                }
+                break;
+            }
+            case 8: scheduler.viewRecurringTasks(); break;
+            case 9: {
+                int id;
+                std::cout << "Enter recurring task id to remove: ";
+                if (std::cin >> id) scheduler.removeRecurringTask(id);
+                else { std::cin.clear(); std::string junk; std::getline(std::cin, junk); std::cout << "Invalid id.\n"; }
+                break;
+            }
+            case 10: {
+                int source = 0, maxWorkers = 0;
+                std::cout << "Workload (0 = current backlog, 1 = finished log): ";
+                if (!(std::cin >> source) || source < 0 || source > 1) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid workload.\n";
+                    break;
+                }
+                std::cout << "Simulate up to how many workers: ";
+                if (!(std::cin >> maxWorkers) || maxWorkers < 1) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid worker count.\n";
+                    break;
+                }
+                std::vector<SimJob> jobs = source == 0
+                    ? Simulator::currentWorkload(scheduler, scheduler.now())
+                    : Simulator::recordedWorkload(scheduler);
+                std::cout << "--- Simulation (" << jobs.size() << " jobs) ---\n";
+                if (jobs.empty()) {
+                    std::cout << "(none)\n";
+                    break;
+                }
+                for (const auto& r : Simulator::sweep(jobs, maxWorkers)) {
+                    std::cout << r.getDetails() << "\n";
+                }
+                break;
+            }
+            case 11: {
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::string query;
+                int mode = 0, status = 0;
+                std::cout << "Search for: ";
+                std::getline(std::cin, query);
+                std::cout << "Match (0 = anywhere, 1 = prefix): ";
+                if (!(std::cin >> mode) || mode < 0 || mode > 1) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid match mode.\n";
+                    break;
+                }
+                std::cout << "Status (0 = all, 1 = staged, 2 = active, 3 = finished): ";
+                if (!(std::cin >> status) || status < 0 || status > 3) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid status.\n";
+                    break;
+                }
+                SearchFilter filter;
+                if (status != 0) {
+                    filter.includeStaged = status == 1;
+                    filter.includeActive = status == 2;
+                    filter.includeFinished = status == 3;
+                }
+                auto results = scheduler.searchTasks(query, mode == 1 ? SearchMode::Prefix : SearchMode::Substring, filter);
+                std::cout << "--- Search Results (" << results.size() << ") ---\n";
+                if (results.empty()) std::cout << "(none)\n";
+                for (const auto& t : results) std::cout << t.getDetails() << "\n";
+                break;
+            }
+            case 12: {
+                int key = 0, order = 0, pageSize = 0, page = 0;
+                std::cout << "Sort by (0 = staged estimate, 1 = actual duration, 2 = overrun, 3 = finish time): ";
+                if (!(std::cin >> key) || key < 0 || key > 3) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid sort key.\n";
+                    break;
+                }
+                std::cout << "Order (0 = largest first, 1 = smallest first): ";
+                if (!(std::cin >> order) || order < 0 || order > 1) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid order.\n";
+                    break;
+                }
+                std::cout << "Page size and page number (from 1): ";
+                if (!(std::cin >> pageSize >> page) || pageSize < 1 || page < 1) {
+                    std::cin.clear(); std::string junk; std::getline(std::cin, junk);
+                    std::cout << "Invalid page.\n";
+                    break;
+                }
+                SortKey sortKey = static_cast<SortKey>(key);
+                std::size_t total = scheduler.getSortedCount(sortKey);
+                std::size_t pages = (total + pageSize - 1) / pageSize;
+                auto tasks = scheduler.getSortedTasks(sortKey, static_cast<std::size_t>(page - 1) * pageSize,
+                                                      pageSize, order == 0);
+                std::cout << "--- Sorted Tasks (page " << page << " of " << pages << ", " << total << " total) ---\n";
+                if (tasks.empty()) std::cout << "(none)\n";
+                for (const auto& t : tasks) std::cout << t.getDetails() << "\n";
+                break;
+            }
             case 0: running = false; break;
             default: std::cout << "Unknown option. Try again.\n"; break;
         }
@@ -3,7 +3,9 @@
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/dom/elements.hpp"
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 /**
@@ -33,6 +35,16 @@ int main() {
     std::string input_description = "";
     std::string input_estimate = "";
     std::string input_task_id = "";
+    std::string input_schedule = "";
+    int policy_selected = 0;
+    std::string input_search = "";
+    int search_mode_selected = 0;
+    int search_status_selected = 0;
+    int staged_sort_selected = 0;
+    int finished_sort_selected = 0;
+    int sort_order_selected = 0;
+    std::size_t page_index = 0;
+    const std::size_t page_size = 20;
     std::string status_message = "";
     
     auto screen = ScreenInteractive::Fullscreen();
@@ -45,13 +57,39 @@ int main() {
         "View Staged Tasks",
         "View Active Tasks",
         "View Finished Log",
+        "Add Recurring Task",
+        "View Recurring Tasks",
+        "Remove Recurring Task",
+        "Search Tasks",
         "Exit"
     };
+
+    // Catch-up policy choices, in CatchUpPolicy order
+    std::vector<std::string> policy_entries = {"Run once", "Run all", "Skip"};
+
+    // Search filters
+    std::vector<std::string> search_mode_entries = {"Anywhere", "Prefix"};
+    std::vector<std::string> search_status_entries = {"All", "Staged", "Active", "Finished"};
+
+    // Sorted views
+    std::vector<std::string> staged_sort_entries = {"Added order", "Estimate"};
+    std::vector<std::string> finished_sort_entries = {"Finished order", "Duration", "Overrun", "Finish time"};
+    std::vector<std::string> sort_order_entries = {"Largest first", "Smallest first"};
     
     // Input components
     auto input_desc_component = Input(&input_description, "Task description");
     auto input_est_component = Input(&input_estimate, "Estimate (seconds)");
     auto input_id_component = Input(&input_task_id, "Task ID");
+    auto input_schedule_component = Input(&input_schedule, "Interval (seconds) or cron expression");
+    auto policy_component = Toggle(&policy_entries, &policy_selected);
+    auto input_search_component = Input(&input_search, "Search descriptions");
+    auto search_mode_component = Toggle(&search_mode_entries, &search_mode_selected);
+    auto search_status_component = Toggle(&search_status_entries, &search_status_selected);
+    auto staged_sort_component = Toggle(&staged_sort_entries, &staged_sort_selected);
+    auto finished_sort_component = Toggle(&finished_sort_entries, &finished_sort_selected);
+    auto sort_order_component = Toggle(&sort_order_entries, &sort_order_selected);
+    auto prev_page_button = Button("◀ Prev", [&] { if (page_index > 0) --page_index; });
+    auto next_page_button = Button("Next ▶", [&] { ++page_index; });
     
     // Menu
     auto menu = Menu(&menu_entries, &selected);
@@ -107,18 +145,77 @@ int main() {
                 }
                 break;
             }
-            case 6: // Exit
+            case 6: { // Add Recurring Task
+                if (!input_description.empty() && !input_estimate.empty() && !input_schedule.empty()) {
+                    try {
+                        int estimate = std::stoi(input_estimate);
+                        CatchUpPolicy policy = static_cast<CatchUpPolicy>(policy_selected);
+                        if (input_schedule.find_first_not_of("0123456789") == std::string::npos) {
+                            scheduler.addRecurringTask(input_description, estimate, std::stoll(input_schedule), policy);
+                        } else {
+                            scheduler.addCronTask(input_description, estimate, input_schedule, policy);
+                        }
+                        status_message = "✓ Recurring task added!";
+                        input_description = "";
+                        input_estimate = "";
+                        input_schedule = "";
+                    } catch (const std::out_of_range&) {
+                        status_message = "✗ Invalid recurring task: number is too large";
+                    } catch (const std::exception& e) {
+                        status_message = std::string("✗ Invalid recurring task: ") + e.what();
+                    }
+                } else {
+                    status_message = "✗ Please fill in all fields";
+                }
+                break;
+            }
+            case 8: { // Remove Recurring Task
+                if (!input_task_id.empty()) {
+                    try {
+                        int id = std::stoi(input_task_id);
+                        if (scheduler.removeRecurringTask(id)) {
+                            status_message = "✓ Recurring task removed!";
+                            input_task_id = "";
+                        } else {
+                            status_message = "✗ Recurring task not found";
+                        }
+                    } catch (...) {
+                        status_message = "✗ Invalid recurring task ID";
+                    }
+                } else {
+                    status_message = "✗ Please enter a recurring task ID";
+                }
+                break;
+            }
+            case 10: // Exit
                 screen.ExitLoopClosure()();
                 break;
         }
     });
     
-    // Combine components
+    // Combine components; each control only takes focus while its view is shown
+    auto shown_in = [&](std::initializer_list<int> views) {
+        std::vector<int> list(views);
+        return [&selected, list] { return std::find(list.begin(), list.end(), selected) != list.end(); };
+    };
     auto input_container = Container::Vertical({
-        input_desc_component,
-        input_est_component,
-        input_id_component,
-        action_button,
+        Maybe(input_desc_component, shown_in({0, 6})),
+        Maybe(input_est_component, shown_in({0, 6})),
+        Maybe(input_id_component, shown_in({1, 2, 8})),
+        Maybe(input_schedule_component, shown_in({6})),
+        Maybe(policy_component, shown_in({6})),
+        Maybe(input_search_component, shown_in({9})),
+        Maybe(search_mode_component, shown_in({9})),
+        Maybe(search_status_component, shown_in({9})),
+        Maybe(staged_sort_component, shown_in({3})),
+        Maybe(finished_sort_component, shown_in({5})),
+        Maybe(sort_order_component, [&] {
+            // List order has no direction to choose, so only sorted views offer one
+            return (selected == 3 && staged_sort_selected != 0) || (selected == 5 && finished_sort_selected != 0);
+        }),
+        Maybe(prev_page_button, shown_in({3, 5})),
+        Maybe(next_page_button, shown_in({3, 5})),
+        Maybe(action_button, shown_in({0, 1, 2, 6, 8, 10})),
     });
     
     auto main_container = Container::Horizontal({
@@ -127,13 +224,47 @@ int main() {
     });
     
     auto renderer = Renderer(main_container, [&] {
+        // Stage any recurring runs that came due since the last redraw
+        scheduler.releaseDueTasks();
+
         // Build task display based on selected view
         Elements task_display;
         
+        // Paging controls shared by the staged and finished views; clamps
+        // page_index to the last page and returns the offset of the page.
+        // The order toggle is only drawn when a sort key is selected.
+        bool descending = sort_order_selected == 0;
+        auto add_paging = [&](Component sort_component, std::size_t total, bool sorted) {
+            std::size_t pages = std::max<std::size_t>(1, (total + page_size - 1) / page_size);
+            if (page_index >= pages) page_index = pages - 1;
+            task_display.push_back(hbox({text("Sort: "), sort_component->Render()}));
+            Elements controls;
+            if (sorted) {
+                controls.push_back(text("Order: "));
+                controls.push_back(sort_order_component->Render());
+                controls.push_back(text("  "));
+            }
+            controls.push_back(prev_page_button->Render());
+            controls.push_back(next_page_button->Render());
+            controls.push_back(text("  Page " + std::to_string(page_index + 1) + " of " + std::to_string(pages)) | dim);
+            task_display.push_back(hbox(std::move(controls)));
+            task_display.push_back(separator());
+            return page_index * page_size;
+        };
+
         if (selected == 3) { // Staged Tasks
             task_display.push_back(text("Staged Tasks") | bold | color(Color::Cyan));
             task_display.push_back(separator());
-            auto& tasks = scheduler.getStagedTasks();
+            std::vector<Task> tasks;
+            if (staged_sort_selected == 1) {
+                std::size_t offset = add_paging(staged_sort_component, scheduler.getSortedCount(SortKey::Estimate), true);
+                tasks = scheduler.getSortedTasks(SortKey::Estimate, offset, page_size, descending);
+            } else {
+                auto& all = scheduler.getStagedTasks();
+                std::size_t offset = add_paging(staged_sort_component, all.size(), false);
+                std::size_t end = std::min(all.size(), offset + page_size);
+                tasks.assign(all.begin() + offset, all.begin() + end);
+            }
             if (tasks.empty()) {
                 task_display.push_back(text("(none)") | dim);
             } else {
@@ -157,7 +288,18 @@ int main() {
         } else if (selected == 5) { // Finished Tasks
             task_display.push_back(text("Finished Tasks") | bold | color(Color::Green));
             task_display.push_back(separator());
-            auto& tasks = scheduler.getFinishedTasks();
+            std::vector<Task> tasks;
+            if (finished_sort_selected != 0) {
+                const SortKey keys[] = {SortKey::ActualDuration, SortKey::Overrun, SortKey::FinishTime};
+                SortKey key = keys[finished_sort_selected - 1];
+                std::size_t offset = add_paging(finished_sort_component, scheduler.getSortedCount(key), true);
+                tasks = scheduler.getSortedTasks(key, offset, page_size, descending);
+            } else {
+                auto& all = scheduler.getFinishedTasks();
+                std::size_t offset = add_paging(finished_sort_component, all.size(), false);
+                std::size_t end = std::min(all.size(), offset + page_size);
+                tasks.assign(all.begin() + offset, all.begin() + end);
+            }
             if (tasks.empty()) {
                 task_display.push_back(text("(none)") | dim);
             } else {
@@ -166,8 +308,21 @@ int main() {
                     if (t.startTime != 0 && t.finishTime != 0) {
                         duration = static_cast<long long>(std::difftime(t.finishTime, t.startTime));
                     }
+                    int overrun = static_cast<int>(100.0 * duration / std::max(1, t.estimatedDurationSeconds));
                     task_display.push_back(text("[#" + std::to_string(t.id) + "] " + t.description + 
-                        " | Actual: " + std::to_string(duration) + " sec"));
+                        " | Actual: " + std::to_string(duration) + " sec" +
+                        " | " + std::to_string(overrun) + "% of estimate"));
+                }
+            }
+        } else if (selected == 7) { // Recurring Tasks
+            task_display.push_back(text("Recurring Tasks") | bold | color(Color::Magenta));
+            task_display.push_back(separator());
+            auto recurring = scheduler.getRecurringTasks();
+            if (recurring.empty()) {
+                task_display.push_back(text("(none)") | dim);
+            } else {
+                for (const auto& r : recurring) {
+                    task_display.push_back(text(r.getDetails()));
                 }
             }
         }
@@ -191,8 +346,67 @@ int main() {
                 separator(),
                 action_button->Render(),
             }) | border;
-        } else if (selected == 3 || selected == 4 || selected == 5) {
+        } else if (selected == 6) {
+            input_panel = vbox({
+                text("Add Recurring Task") | bold | color(Color::Cyan),
+                separator(),
+                input_desc_component->Render(),
+                input_est_component->Render(),
+                input_schedule_component->Render(),
+                hbox({text("Missed runs: "), policy_component->Render()}),
+                separator(),
+                action_button->Render(),
+            }) | border;
+        } else if (selected == 8) {
+            Elements rows;
+            for (const auto& r : scheduler.getRecurringTasks()) rows.push_back(text(r.getDetails()));
+            if (rows.empty()) rows.push_back(text("(none)") | dim);
+            input_panel = vbox({
+                text("Remove Recurring Task") | bold | color(Color::Cyan),
+                separator(),
+                input_id_component->Render(),
+                separator(),
+                action_button->Render(),
+                separator(),
+                vbox(rows) | flex,
+            }) | border | flex;
+        } else if (selected == 9) {
+            // Results are recomputed on every redraw, i.e. on each keystroke
+            SearchFilter filter;
+            if (search_status_selected != 0) {
+                filter.includeStaged = search_status_selected == 1;
+                filter.includeActive = search_status_selected == 2;
+                filter.includeFinished = search_status_selected == 3;
+            }
+            SearchMode mode = search_mode_selected == 1 ? SearchMode::Prefix : SearchMode::Substring;
+            auto results = scheduler.searchTasks(input_search, mode, filter, 50);
+
+            Elements rows;
+            if (results.empty()) {
+                rows.push_back(text("(none)") | dim);
+            } else {
+                for (const auto& t : results) {
+                    rows.push_back(text("[#" + std::to_string(t.id) + "] " + t.description +
+                        " | " + statusToString(t.status)));
+                }
+            }
+            input_panel = vbox({
+                text("Search Tasks") | bold | color(Color::Cyan),
+                separator(),
+                input_search_component->Render(),
+                hbox({text("Match: "), search_mode_component->Render()}),
+                hbox({text("Status: "), search_status_component->Render()}),
+                separator(),
+                vbox(rows) | flex,
+            }) | border | flex;
+        } else if (selected == 3 || selected == 4 || selected == 5 || selected == 7) {
             input_panel = vbox(task_display) | border | flex;
+        } else if (selected == 10) {
+            input_panel = vbox({
+                text("Exit") | bold | color(Color::Cyan),
+                separator(),
+                action_button->Render(),
+            }) | border;
         } else {
             input_panel = vbox({
                 text("Select an action from the menu") | dim,